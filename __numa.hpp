@@ -21,7 +21,32 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#  include <charconv>
+#  include <filesystem>
+#  include <fstream>
+#  include <string>
+#  include <string_view>
+#  include <system_error>
+
+#  include <new>
+
+#  include <sched.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+// Define STDEXEC_ENABLE_SYSFS_NUMA to 1 to let Linux builds without libnuma use
+// sysfs_numa_policy by default. Pools then pin each worker to the cpus of its node and make it
+// prefer the memory of that node. Otherwise these builds default to no_numa_policy.
+#ifndef STDEXEC_ENABLE_SYSFS_NUMA
+#  define STDEXEC_ENABLE_SYSFS_NUMA 0
+#endif
 
 namespace exec {
   struct numa_policy {
@@ -30,6 +55,17 @@ namespace exec {
     virtual auto num_cpus(int node) -> std::size_t = 0;
     virtual auto bind_to_node(int node) -> int = 0;
     virtual auto thread_index_to_node(std::size_t index) -> int = 0;
+
+    // Returns the cpu that the thread with this index is meant to run on, or -1 if the policy
+    // does not know.
+    virtual auto thread_index_to_cpu(std::size_t /* index */) -> int {
+      return -1;
+    }
+
+    // Returns the node of `cpu`, or -1 if the policy does not know.
+    virtual auto cpu_to_node(int /* cpu */) -> int {
+      return -1;
+    }
   };
 
   class no_numa_policy : public numa_policy {
@@ -52,6 +88,337 @@ namespace exec {
       return 0;
     }
   };
+
+#if defined(__linux__)
+  // A numa_policy that reads the topology from sysfs and talks to the kernel directly, so it
+  // needs no libnuma. Only nodes with cpus that this process may run on, according to
+  // sched_getaffinity, are used. Nodes are named by their kernel ids, which need not be
+  // contiguous. bind_to_node() changes the affinity and the memory policy of the calling
+  // thread. Pass another `root` to read a fake node directory, e.g. in tests.
+  class sysfs_numa_policy : public numa_policy {
+   public:
+    explicit sysfs_numa_policy(
+      const std::filesystem::path& root = "/sys/devices/system/node") noexcept {
+      try {
+        read_nodes(root);
+      } catch (...) {
+        nodes_.clear();
+        node_to_thread_index_.clear();
+      }
+    }
+
+    // Returns 0 if the node directory could not be read.
+    auto num_nodes() -> std::size_t override {
+      return nodes_.size();
+    }
+
+    auto num_cpus(int node) -> std::size_t override {
+      const node_info* info = find_node(node);
+      return info ? info->cpus.size() : 0;
+    }
+
+    // Restricts the calling thread to the cpus of `node` and lets it prefer the memory of
+    // `node` for the pages it touches first.
+    auto bind_to_node(int node) -> int override {
+      const node_info* info = find_node(node);
+      if (!info) {
+        return -1;
+      }
+      ::cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for (int cpu: info->cpus) {
+        CPU_SET(cpu, &cpus);
+      }
+      if (::sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+        return -1;
+      }
+      std::vector<unsigned long> mask = make_mask(info->id);
+      if (::syscall(SYS_set_mempolicy, mpol_preferred, mask.data(), max_node(mask)) != 0) {
+        return -1;
+      }
+      return 0;
+    }
+
+    auto thread_index_to_node(std::size_t index) -> int override {
+      if (node_to_thread_index_.empty()) {
+        return 0;
+      }
+      return nodes_[position_of_thread(index % node_to_thread_index_.back())].id;
+    }
+
+    // The threads of a node take the cpus of the node in order.
+    auto thread_index_to_cpu(std::size_t index) -> int override {
+      if (node_to_thread_index_.empty()) {
+        return -1;
+      }
+      index %= node_to_thread_index_.back();
+      const std::size_t pos = position_of_thread(index);
+      const std::size_t offset = index - (pos == 0 ? 0 : node_to_thread_index_[pos - 1]);
+      return nodes_[pos].cpus[offset];
+    }
+
+    auto cpu_to_node(int cpu) -> int override {
+      for (const node_info& info: nodes_) {
+        if (std::find(info.cpus.begin(), info.cpus.end(), cpu) != info.cpus.end()) {
+          return info.id;
+        }
+      }
+      return -1;
+    }
+
+    // Asks the kernel to place the pages of `[addr, addr + len)` on `node`. `addr` has to be
+    // page aligned. Pages that were already touched stay where they are.
+    auto bind_memory(void* addr, std::size_t len, int node) noexcept -> int {
+      const node_info* info = find_node(node);
+      if (!info) {
+        return -1;
+      }
+      try {
+        std::vector<unsigned long> mask = make_mask(info->id);
+        return static_cast<int>(
+          ::syscall(SYS_mbind, addr, len, mpol_preferred, mask.data(), max_node(mask), 0u));
+      } catch (...) {
+        return -1;
+      }
+    }
+
+    // Returns the cpus of a sysfs cpulist such as "0-3,8,10-11".
+    static auto parse_cpu_list(std::string_view list) -> std::vector<int> {
+      std::vector<int> cpus;
+      const char* it = list.data();
+      const char* end = list.data() + list.size();
+      while (it != end) {
+        int first = 0;
+        auto [next, ec] = std::from_chars(it, end, first);
+        if (ec != std::errc{}) {
+          break;
+        }
+        int last = first;
+        if (next != end && *next == '-') {
+          auto [next_last, ec_last] = std::from_chars(next + 1, end, last);
+          if (ec_last != std::errc{}) {
+            break;
+          }
+          next = next_last;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+          cpus.push_back(cpu);
+        }
+        if (next == end || *next != ',') {
+          break;
+        }
+        it = next + 1;
+      }
+      return cpus;
+    }
+
+   private:
+    // The value of MPOL_PREFERRED in <linux/mempolicy.h>, which conflicts with <numaif.h>.
+    static constexpr int mpol_preferred = 1;
+    static constexpr std::size_t bits_per_word = 8 * sizeof(unsigned long);
+
+    struct node_info {
+      int id;
+      std::vector<int> cpus;
+    };
+
+    // Sorted by id.
+    std::vector<node_info> nodes_{};
+    // node_to_thread_index_[i] is the first thread index after the threads of nodes_[i].
+    std::vector<std::size_t> node_to_thread_index_{};
+
+    auto find_node(int id) const noexcept -> const node_info* {
+      auto it = std::lower_bound(
+        nodes_.begin(), nodes_.end(), id, [](const node_info& info, int value) {
+          return info.id < value;
+        });
+      return it != nodes_.end() && it->id == id ? &*it : nullptr;
+    }
+
+    // Returns the position in nodes_ of the node of thread `index`, which is below the thread
+    // count.
+    auto position_of_thread(std::size_t index) const noexcept -> std::size_t {
+      auto it = std::upper_bound(node_to_thread_index_.begin(), node_to_thread_index_.end(), index);
+      return static_cast<std::size_t>(std::distance(node_to_thread_index_.begin(), it));
+    }
+
+    void read_nodes(const std::filesystem::path& root) {
+      ::cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      const bool has_affinity = ::sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+      std::error_code ec;
+      for (const auto& entry: std::filesystem::directory_iterator(root, ec)) {
+        const std::string name = entry.path().filename().string();
+        int id = -1;
+        const char* first = name.data() + 4;
+        const char* last = name.data() + name.size();
+        if (
+          name.size() <= 4 || name.compare(0, 4, "node") != 0
+          || std::from_chars(first, last, id).ptr != last) {
+          continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (!std::getline(file, list)) {
+          continue;
+        }
+        node_info info{id, {}};
+        for (int cpu: parse_cpu_list(list)) {
+          if (cpu < CPU_SETSIZE && (!has_affinity || CPU_ISSET(cpu, &allowed))) {
+            info.cpus.push_back(cpu);
+          }
+        }
+        if (!info.cpus.empty()) {
+          nodes_.push_back(std::move(info));
+        }
+      }
+      std::sort(nodes_.begin(), nodes_.end(), [](const node_info& lhs, const node_info& rhs) {
+        return lhs.id < rhs.id;
+      });
+      std::size_t total_cpus = 0;
+      for (const node_info& info: nodes_) {
+        total_cpus += info.cpus.size();
+        node_to_thread_index_.push_back(total_cpus);
+      }
+    }
+
+    static auto make_mask(int id) -> std::vector<unsigned long> {
+      const auto bit = static_cast<std::size_t>(id);
+      std::vector<unsigned long> mask(bit / bits_per_word + 1);
+      mask[bit / bits_per_word] |= 1ul << (bit % bits_per_word);
+      return mask;
+    }
+
+    // The kernel ignores the last bit of the mask.
+    static auto max_node(const std::vector<unsigned long>& mask) noexcept -> unsigned long {
+      return mask.size() * bits_per_word + 1;
+    }
+  };
+#endif
+
+  // Which cpus are SMT siblings of one core and which share a last level cache, as read from
+  // /sys/devices/system/cpu. Cpus that are unknown or negative share neither with any cpu.
+  class cpu_topology {
+   public:
+    // Knows no cpus.
+    cpu_topology() noexcept = default;
+
+    // Returns the topology of this machine, which is empty on other systems than Linux.
+    static auto system() noexcept -> cpu_topology {
+#if defined(__linux__)
+      return cpu_topology("/sys/devices/system/cpu");
+#else
+      return {};
+#endif
+    }
+
+#if defined(__linux__)
+    // Pass another `root` to read a fake cpu directory, e.g. in tests.
+    explicit cpu_topology(const std::filesystem::path& root) noexcept {
+      try {
+        read_cpus(root);
+      } catch (...) {
+        core_.clear();
+        cache_.clear();
+      }
+    }
+#endif
+
+    [[nodiscard]]
+    auto same_core(int lhs, int rhs) const noexcept -> bool {
+      return same_group(core_, lhs, rhs);
+    }
+
+    [[nodiscard]]
+    auto same_cache(int lhs, int rhs) const noexcept -> bool {
+      return same_group(cache_, lhs, rhs);
+    }
+
+    // Returns the lowest cpu of the core of `cpu`, or -1 if it is unknown.
+    [[nodiscard]]
+    auto core_of(int cpu) const noexcept -> int {
+      return group_of(core_, cpu);
+    }
+
+    // Returns the lowest cpu that shares the last level cache with `cpu`, or -1 if it is
+    // unknown.
+    [[nodiscard]]
+    auto cache_of(int cpu) const noexcept -> int {
+      return group_of(cache_, cpu);
+    }
+
+   private:
+    // group[cpu] is the lowest cpu of the group of `cpu`, or -1 if it is unknown.
+    std::vector<int> core_{};
+    std::vector<int> cache_{};
+
+    static auto group_of(const std::vector<int>& group, int cpu) noexcept -> int {
+      if (cpu < 0 || static_cast<std::size_t>(cpu) >= group.size()) {
+        return -1;
+      }
+      return group[static_cast<std::size_t>(cpu)];
+    }
+
+    static auto same_group(const std::vector<int>& group, int lhs, int rhs) noexcept -> bool {
+      const int first = group_of(group, lhs);
+      return first >= 0 && first == group_of(group, rhs);
+    }
+
+#if defined(__linux__)
+    // Returns the lowest cpu of the cpulist in `file`, or -1.
+    static auto first_cpu(const std::filesystem::path& file) -> int {
+      std::ifstream stream(file);
+      std::string list;
+      if (!std::getline(stream, list)) {
+        return -1;
+      }
+      std::vector<int> cpus = sysfs_numa_policy::parse_cpu_list(list);
+      return cpus.empty() ? -1 : *std::min_element(cpus.begin(), cpus.end());
+    }
+
+    static void assign(std::vector<int>& group, int cpu, int first) {
+      if (group.size() <= static_cast<std::size_t>(cpu)) {
+        group.resize(static_cast<std::size_t>(cpu) + 1, -1);
+      }
+      group[static_cast<std::size_t>(cpu)] = first;
+    }
+
+    void read_cpus(const std::filesystem::path& root) {
+      std::error_code ec;
+      for (const auto& entry: std::filesystem::directory_iterator(root, ec)) {
+        const std::string name = entry.path().filename().string();
+        int cpu = -1;
+        const char* first = name.data() + 3;
+        const char* last = name.data() + name.size();
+        if (
+          name.size() <= 3 || name.compare(0, 3, "cpu") != 0
+          || std::from_chars(first, last, cpu).ptr != last) {
+          continue;
+        }
+        assign(core_, cpu, first_cpu(entry.path() / "topology" / "thread_siblings_list"));
+
+        // The data or unified cache with the highest level is the last level cache.
+        int level = 0;
+        int cache = -1;
+        for (const auto& index: std::filesystem::directory_iterator(entry.path() / "cache", ec)) {
+          std::ifstream type_file(index.path() / "type");
+          std::ifstream level_file(index.path() / "level");
+          std::string type;
+          int index_level = 0;
+          if (!(type_file >> type) || type == "Instruction" || !(level_file >> index_level)) {
+            continue;
+          }
+          if (index_level > level) {
+            level = index_level;
+            cache = first_cpu(index.path() / "shared_cpu_list");
+          }
+        }
+        assign(cache_, cpu, cache);
+      }
+    }
+#endif
+  };
 } // namespace exec
 
 #if STDEXEC_ENABLE_NUMA
@@ -109,12 +476,40 @@ namespace exec {
       return (int) std::distance(node_to_thread_index_.begin(), it);
     }
 
+    int thread_index_to_cpu(std::size_t idx) override {
+      int index = (int) idx % node_to_thread_index_.back();
+      int node = thread_index_to_node(idx);
+      int offset = index - (node == 0 ? 0 : node_to_thread_index_[node - 1]);
+      struct ::bitmask* cpus = ::numa_allocate_cpumask();
+      if (!cpus) {
+        return -1;
+      }
+      scope_guard sg{[&]() noexcept {
+        ::numa_free_cpumask(cpus);
+      }};
+      if (::numa_node_to_cpus(node, cpus) < 0) {
+        return -1;
+      }
+      for (unsigned cpu = 0; cpu < cpus->size; ++cpu) {
+        if (::numa_bitmask_isbitset(cpus, cpu) && offset-- == 0) {
+          return (int) cpu;
+        }
+      }
+      return -1;
+    }
+
+    int cpu_to_node(int cpu) override {
+      return ::numa_node_of_cpu(cpu);
+    }
+
     std::vector<int> node_to_thread_index_{};
   };
 
+  // The policy lives until the program exits, so pools may use it after the thread that
+  // created them has ended.
   inline numa_policy* get_numa_policy() noexcept {
-    thread_local default_numa_policy g_default_numa_policy{};
-    thread_local no_numa_policy g_no_numa_policy{};
+    static default_numa_policy g_default_numa_policy{};
+    static no_numa_policy g_no_numa_policy{};
     if (::numa_available() < 0) {
       return &g_no_numa_policy;
     }
@@ -213,13 +608,78 @@ namespace exec {
 } // namespace exec
 #else
 namespace exec {
+#  if defined(__linux__) && STDEXEC_ENABLE_SYSFS_NUMA
+  using default_numa_policy = sysfs_numa_policy;
+
+  inline auto __sysfs_numa_policy() noexcept -> sysfs_numa_policy& {
+    static sysfs_numa_policy g_sysfs_numa_policy{};
+    return g_sysfs_numa_policy;
+  }
+
+  // The policy lives until the program exits, so pools may use it after the thread that
+  // created them has ended.
+  inline auto get_numa_policy() noexcept -> numa_policy* {
+    static no_numa_policy g_no_numa_policy{};
+    if (__sysfs_numa_policy().num_nodes() == 0) {
+      return &g_no_numa_policy;
+    }
+    return &__sysfs_numa_policy();
+  }
+
+  // Like numa_alloc_onnode(), every allocation maps whole pages, which the kernel is asked to
+  // place on the node before they are first touched.
+  template <class T>
+  struct numa_allocator {
+    using pointer = T*;
+    using const_pointer = const T*;
+    using value_type = T;
+
+    explicit numa_allocator(int node) noexcept
+      : node_(node) {
+    }
+
+    template <class U>
+    explicit numa_allocator(const numa_allocator<U>& other) noexcept
+      : node_(other.node_) {
+    }
+
+    int node_;
+
+    auto allocate(std::size_t n) -> T* {
+      const std::size_t size = mapped_size(n);
+      void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      // If the node is unknown, the pages go wherever the kernel puts them.
+      __sysfs_numa_policy().bind_memory(p, size, node_);
+      return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+      ::munmap(p, mapped_size(n));
+    }
+
+    friend auto operator==(const numa_allocator&, const numa_allocator&) noexcept -> bool = default;
+
+   private:
+    static auto mapped_size(std::size_t n) noexcept -> std::size_t {
+      const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      const std::size_t bytes = std::max<std::size_t>(n * sizeof(T), 1);
+      return (bytes + page - 1) / page * page;
+    }
+  };
+#  else
   using default_numa_policy = no_numa_policy;
 
+  // The policy lives until the program exits, so pools may use it after the thread that
+  // created them has ended.
   inline auto get_numa_policy() noexcept -> numa_policy* {
-    thread_local default_numa_policy g_default_numa_policy{};
+    static default_numa_policy g_default_numa_policy{};
     return &g_default_numa_policy;
   }
 
+  // Places nothing. Node-local memory needs libnuma or STDEXEC_ENABLE_SYSFS_NUMA.
   template <class T>
   struct numa_allocator {
     using pointer = T*;
@@ -245,15 +705,19 @@ namespace exec {
 
     friend auto operator==(const numa_allocator&, const numa_allocator&) noexcept -> bool = default;
   };
+#  endif
 
+  // Without libnuma, a nodemask covers the first 64 nodes.
   class nodemask {
     static auto make_any() noexcept -> nodemask {
       nodemask mask;
-      mask.mask_ = true;
+      mask.mask_ = ~std::uint64_t{0};
       return mask;
     }
 
    public:
+    static constexpr std::size_t max_nodes = 64;
+
     nodemask() noexcept = default;
 
     static auto any() noexcept -> const nodemask& {
@@ -262,11 +726,13 @@ namespace exec {
     }
 
     auto operator[](std::size_t nodemask) const noexcept -> bool {
-      return mask_ && nodemask == 0;
+      return nodemask < max_nodes && ((mask_ >> nodemask) & 1u) != 0;
     }
 
     void set(std::size_t nodemask) noexcept {
-      mask_ |= nodemask == 0;
+      if (nodemask < max_nodes) {
+        mask_ |= std::uint64_t{1} << nodemask;
+      }
     }
 
     friend auto operator==(const nodemask& lhs, const nodemask& rhs) noexcept -> bool {
@@ -274,7 +740,7 @@ namespace exec {
     }
 
    private:
-    bool mask_{false};
+    std::uint64_t mask_{0};
   };
 } // namespace exec
 #endif
\ No newline at end of file
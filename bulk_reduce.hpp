@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "../stdexec/concepts.hpp"
+#include "../stdexec/__detail/__meta.hpp"
+#include "../stdexec/__detail/__basic_sender.hpp"
+
+#include <exception>
+
+namespace exec {
+  // bulk_reduce(sndr, shape, init, map, reduce) completes with
+  //
+  //   reduce(... reduce(reduce(init, map(0, values...)), map(1, values...)) ..., map(shape - 1, values...))
+  //
+  // where values are the values sent by sndr. Schedulers may evaluate the terms in any order
+  // and grouping. Therefore reduce has to be associative and commutative, it has to accept two
+  // accumulators, and map(i, values...) has to be convertible to the type of init.
+  namespace __bulk_reduce {
+    using namespace stdexec;
+
+    template <class _Shape, class _Init, class _Map, class _Reduce>
+    struct __data {
+      _Shape __shape_;
+      _Init __init_;
+      STDEXEC_ATTRIBUTE((no_unique_address))
+      _Map __map_;
+      STDEXEC_ATTRIBUTE((no_unique_address))
+      _Reduce __reduce_;
+      static constexpr auto __mbrs_ = __mliterals<
+        &__data::__shape_,
+        &__data::__init_,
+        &__data::__map_,
+        &__data::__reduce_>();
+    };
+    template <class _Shape, class _Init, class _Map, class _Reduce>
+    __data(_Shape, _Init, _Map, _Reduce) -> __data<_Shape, _Init, _Map, _Reduce>;
+
+    template <class _CvrefSender, class _Env, class _Init>
+    using __completions_t = //
+      __try_make_completion_signatures<
+        _CvrefSender,
+        _Env,
+        stdexec::completion_signatures<set_error_t(std::exception_ptr), set_value_t(_Init)>,
+        __mconst<stdexec::completion_signatures<>>>;
+
+    struct __bulk_reduce_impl : __sexpr_defaults {
+      template <class _Sender>
+      using __init_t = decltype(__decay_t<__data_of<_Sender>>::__init_);
+
+      static constexpr auto get_completion_signatures = //
+        []<class _Sender, class _Env>(_Sender &&, _Env &&) noexcept
+        -> __completions_t<__child_of<_Sender>, _Env, __init_t<_Sender>> {
+        return {};
+      };
+
+      static constexpr auto complete = //
+        []<class _Tag, class... _Args>(
+          __ignore,
+          auto &__state,
+          auto &__rcvr,
+          _Tag,
+          _Args &&...__args) noexcept -> void {
+        if constexpr (same_as<_Tag, set_value_t>) {
+          using __shape_t = decltype(__state.__shape_);
+          using __init_t = decltype(__state.__init_);
+          try {
+            __init_t __acc = static_cast<__init_t &&>(__state.__init_);
+            for (__shape_t __i{}; __i != __state.__shape_; ++__i) {
+              __acc = __state.__reduce_(std::move(__acc), __state.__map_(__i, __args...));
+            }
+            set_value(std::move(__rcvr), std::move(__acc));
+          } catch (...) {
+            set_error(std::move(__rcvr), std::current_exception());
+          }
+        } else {
+          _Tag()(std::move(__rcvr), static_cast<_Args &&>(__args)...);
+        }
+      };
+    };
+
+    struct bulk_reduce_t {
+      template <
+        sender _Sender,
+        integral _Shape,
+        __movable_value _Init,
+        __movable_value _Map,
+        __movable_value _Reduce>
+      auto operator()(
+        _Sender &&__sndr,
+        _Shape __shape,
+        _Init __init,
+        _Map __map,
+        _Reduce __reduce) const -> __well_formed_sender auto {
+        auto __domain = __get_early_domain(__sndr);
+        return stdexec::transform_sender(
+          __domain,
+          __make_sexpr<bulk_reduce_t>(
+            __data{
+              __shape,
+              static_cast<_Init &&>(__init),
+              static_cast<_Map &&>(__map),
+              static_cast<_Reduce &&>(__reduce)},
+            static_cast<_Sender &&>(__sndr)));
+      }
+
+      template <integral _Shape, class _Init, class _Map, class _Reduce>
+      STDEXEC_ATTRIBUTE((always_inline))
+      auto
+        operator()(_Shape __shape, _Init __init, _Map __map, _Reduce __reduce) const
+        -> __binder_back<bulk_reduce_t, _Shape, _Init, _Map, _Reduce> {
+        return {
+          {static_cast<_Shape &&>(__shape),
+           static_cast<_Init &&>(__init),
+           static_cast<_Map &&>(__map),
+           static_cast<_Reduce &&>(__reduce)}
+        };
+      }
+
+      // This describes how to use the pieces of a bulk_reduce sender to find
+      // legacy customizations of the bulk_reduce algorithm.
+      using _Sender = __1;
+      using _Shape = __nth_member<0>(__0);
+      using _Init = __nth_member<1>(__0);
+      using _Map = __nth_member<2>(__0);
+      using _Reduce = __nth_member<3>(__0);
+      using __legacy_customizations_t = __types<
+        tag_invoke_t(
+          bulk_reduce_t,
+          get_completion_scheduler_t<set_value_t>(get_env_t(_Sender &)),
+          _Sender,
+          _Shape,
+          _Init,
+          _Map,
+          _Reduce),
+        tag_invoke_t(bulk_reduce_t, _Sender, _Shape, _Init, _Map, _Reduce)>;
+    };
+  } // namespace __bulk_reduce
+
+  using __bulk_reduce::bulk_reduce_t;
+  inline constexpr bulk_reduce_t bulk_reduce{};
+} // namespace exec
+
+namespace stdexec {
+  template <>
+  struct __sexpr_impl<exec::__bulk_reduce::bulk_reduce_t>
+    : exec::__bulk_reduce::__bulk_reduce_impl { };
+} // namespace stdexec
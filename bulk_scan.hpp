@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "../stdexec/concepts.hpp"
+#include "../stdexec/__detail/__meta.hpp"
+#include "../stdexec/__detail/__basic_sender.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace exec {
+  enum class scan_kind {
+    // output[i] = init op input[0] op ... op input[i]
+    inclusive,
+    // output[0] = init, output[i] = init op input[0] op ... op input[i - 1]
+    exclusive
+  };
+
+  // bulk_scan(sndr, shape, input, output, init, op, kind) writes the prefix scan of the `shape`
+  // elements starting at the random access iterator `input` to `output`, and then completes with
+  // the values sent by sndr. `output` may be equal to `input`. Schedulers may combine the
+  // elements in any grouping, therefore op has to be associative.
+  namespace __bulk_scan {
+    using namespace stdexec;
+
+    // Folds input[begin, end) into acc. The loop only indexes contiguous elements, so that the
+    // compiler can vectorize it for arithmetic types and simple operations.
+    template <class _Shape, class _InIt, class _Tp, class _Op>
+    auto __reduce_block(_InIt __input, _Shape __begin, _Shape __end, _Tp __acc, _Op& __op) -> _Tp {
+      for (_Shape __i = __begin; __i != __end; ++__i) {
+        __acc = __op(std::move(__acc), __input[__i]);
+      }
+      return __acc;
+    }
+
+    // Scans input[begin, end) into output[begin, end), starting with acc.
+    template <class _Shape, class _InIt, class _OutIt, class _Tp, class _Op>
+    void __scan_block(
+      _InIt __input,
+      _OutIt __output,
+      _Shape __begin,
+      _Shape __end,
+      _Tp __acc,
+      _Op& __op,
+      scan_kind __kind) {
+      if (__kind == scan_kind::inclusive) {
+        for (_Shape __i = __begin; __i != __end; ++__i) {
+          __acc = __op(std::move(__acc), __input[__i]);
+          __output[__i] = __acc;
+        }
+      } else {
+        for (_Shape __i = __begin; __i != __end; ++__i) {
+          _Tp __next = __op(__acc, __input[__i]);
+          __output[__i] = std::move(__acc);
+          __acc = std::move(__next);
+        }
+      }
+    }
+
+    template <class _Shape, class _InIt, class _OutIt, class _Tp, class _Op>
+    struct __data {
+      _Shape __shape_;
+      _InIt __input_;
+      _OutIt __output_;
+      _Tp __init_;
+      STDEXEC_ATTRIBUTE((no_unique_address))
+      _Op __op_;
+      scan_kind __kind_;
+      static constexpr auto __mbrs_ = __mliterals<
+        &__data::__shape_,
+        &__data::__input_,
+        &__data::__output_,
+        &__data::__init_,
+        &__data::__op_,
+        &__data::__kind_>();
+    };
+    template <class _Shape, class _InIt, class _OutIt, class _Tp, class _Op>
+    __data(_Shape, _InIt, _OutIt, _Tp, _Op, scan_kind) -> __data<_Shape, _InIt, _OutIt, _Tp, _Op>;
+
+    template <class _CvrefSender, class _Env>
+    using __completions_t = //
+      __try_make_completion_signatures<_CvrefSender, _Env, __with_exception_ptr>;
+
+    struct __bulk_scan_impl : __sexpr_defaults {
+      static constexpr auto get_completion_signatures = //
+        []<class _Sender, class _Env>(_Sender &&, _Env &&) noexcept
+        -> __completions_t<__child_of<_Sender>, _Env> {
+        return {};
+      };
+
+      static constexpr auto complete = //
+        []<class _Tag, class... _Args>(
+          __ignore,
+          auto &__state,
+          auto &__rcvr,
+          _Tag,
+          _Args &&...__args) noexcept -> void {
+        if constexpr (same_as<_Tag, set_value_t>) {
+          using __shape_t = decltype(__state.__shape_);
+          try {
+            __bulk_scan::__scan_block(
+              __state.__input_,
+              __state.__output_,
+              __shape_t{},
+              __state.__shape_,
+              __state.__init_,
+              __state.__op_,
+              __state.__kind_);
+          } catch (...) {
+            set_error(std::move(__rcvr), std::current_exception());
+            return;
+          }
+          _Tag()(std::move(__rcvr), static_cast<_Args &&>(__args)...);
+        } else {
+          _Tag()(std::move(__rcvr), static_cast<_Args &&>(__args)...);
+        }
+      };
+    };
+
+    struct bulk_scan_t {
+      template <
+        sender _Sender,
+        integral _Shape,
+        std::random_access_iterator _InIt,
+        std::random_access_iterator _OutIt,
+        __movable_value _Tp,
+        __movable_value _Op>
+      auto operator()(
+        _Sender &&__sndr,
+        _Shape __shape,
+        _InIt __input,
+        _OutIt __output,
+        _Tp __init,
+        _Op __op,
+        scan_kind __kind = scan_kind::inclusive) const -> __well_formed_sender auto {
+        auto __domain = __get_early_domain(__sndr);
+        return stdexec::transform_sender(
+          __domain,
+          __make_sexpr<bulk_scan_t>(
+            __data{
+              __shape,
+              static_cast<_InIt &&>(__input),
+              static_cast<_OutIt &&>(__output),
+              static_cast<_Tp &&>(__init),
+              static_cast<_Op &&>(__op),
+              __kind},
+            static_cast<_Sender &&>(__sndr)));
+      }
+
+      template <
+        integral _Shape,
+        std::random_access_iterator _InIt,
+        std::random_access_iterator _OutIt,
+        class _Tp,
+        class _Op>
+      STDEXEC_ATTRIBUTE((always_inline))
+      auto
+        operator()(
+          _Shape __shape,
+          _InIt __input,
+          _OutIt __output,
+          _Tp __init,
+          _Op __op,
+          scan_kind __kind = scan_kind::inclusive) const
+        -> __binder_back<bulk_scan_t, _Shape, _InIt, _OutIt, _Tp, _Op, scan_kind> {
+        return {
+          {static_cast<_Shape &&>(__shape),
+           static_cast<_InIt &&>(__input),
+           static_cast<_OutIt &&>(__output),
+           static_cast<_Tp &&>(__init),
+           static_cast<_Op &&>(__op),
+           __kind}
+        };
+      }
+
+      // This describes how to use the pieces of a bulk_scan sender to find
+      // legacy customizations of the bulk_scan algorithm.
+      using _Sender = __1;
+      using _Shape = __nth_member<0>(__0);
+      using _InIt = __nth_member<1>(__0);
+      using _OutIt = __nth_member<2>(__0);
+      using _Tp = __nth_member<3>(__0);
+      using _Op = __nth_member<4>(__0);
+      using _Kind = __nth_member<5>(__0);
+      using __legacy_customizations_t = __types<
+        tag_invoke_t(
+          bulk_scan_t,
+          get_completion_scheduler_t<set_value_t>(get_env_t(_Sender &)),
+          _Sender,
+          _Shape,
+          _InIt,
+          _OutIt,
+          _Tp,
+          _Op,
+          _Kind),
+        tag_invoke_t(bulk_scan_t, _Sender, _Shape, _InIt, _OutIt, _Tp, _Op, _Kind)>;
+    };
+  } // namespace __bulk_scan
+
+  using __bulk_scan::bulk_scan_t;
+  inline constexpr bulk_scan_t bulk_scan{};
+} // namespace exec
+
+namespace stdexec {
+  template <>
+  struct __sexpr_impl<exec::__bulk_scan::bulk_scan_t> : exec::__bulk_scan::__bulk_scan_impl { };
+} // namespace stdexec
@@ -32,6 +32,7 @@
 #  include "./memory_mapped_region.hpp"
 
 #  include "../scope.hpp"
+#  include "../sequence_senders.hpp"
 
 #  if !__has_include(<linux/version.h>)
 #    error "linux/version.h not found. Do you use Linux?"
@@ -47,15 +48,58 @@
 
 #    if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
 #      define STDEXEC_HAS_IORING_OP_READ
+#      define STDEXEC_HAS_IO_URING_SOCKETS
 #    endif
 
+#    if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 0, 0)
+#      define STDEXEC_HAS_IO_URING_MULTISHOT
+#    endif
+
+#    include <sys/socket.h>
 #    include <sys/uio.h>
 #    include <sys/eventfd.h>
 #    include <sys/syscall.h>
 
 #    include <algorithm>
+#    include <array>
+#    include <bit>
+#    include <chrono>
+#    include <memory>
+#    include <new>
+#    include <span>
+#    include <tuple>
+#    include <variant>
 
 namespace exec {
+  // Configures how the kernel processes the rings of an io_uring_context.
+  struct io_uring_context_params {
+    unsigned entries{1024};
+    // Additional raw IORING_SETUP_* flags.
+    unsigned flags{0};
+    // Let a kernel thread poll the submission queue (IORING_SETUP_SQPOLL).
+    // While the thread is awake, submitting needs no system call.
+    bool sqpoll{false};
+    // How long the polling thread spins without work before it goes to sleep.
+    std::chrono::milliseconds sq_thread_idle{1000};
+    // Pins the polling thread to this cpu if it is non-negative.
+    int sq_thread_cpu{-1};
+    // Promise that only the thread that drives the context submits (IORING_SETUP_SINGLE_ISSUER).
+    bool single_issuer{false};
+    // Defer completion work until the driving thread waits for completions
+    // (IORING_SETUP_DEFER_TASKRUN). Implies single_issuer.
+    bool defer_taskrun{false};
+    // Keep schedule_after timers in a timing wheel in user space. Instead of one
+    // IORING_OP_TIMEOUT per timer, the context bounds its wait for completions by the
+    // next expiry. Requires IORING_FEAT_EXT_ARG (Linux 5.11).
+    bool timer_wheel{false};
+    // The tick of the timing wheel. Timers never expire early but may expire up to one
+    // tick late.
+    std::chrono::microseconds timer_wheel_resolution{1000};
+    // The maximum number of completions handled before the context submits again.
+    // Zero means that every pass drains the whole completion queue.
+    unsigned max_completions_per_pass{0};
+  };
+
   namespace __io_uring {
     inline void __throw_error_code_if(bool __cond, int __ec) {
       if (__cond) {
@@ -74,9 +118,25 @@ namespace exec {
       int __ring_fd,
       unsigned int __to_submit,
       unsigned int __min_complete,
-      unsigned int __flags) -> int {
+      unsigned int __flags,
+      const void* __arg = nullptr,
+      std::size_t __arg_size = 0) -> int {
       int rc = static_cast<int>(::syscall(
-        __NR_io_uring_enter, __ring_fd, __to_submit, __min_complete, __flags, nullptr, 0));
+        __NR_io_uring_enter, __ring_fd, __to_submit, __min_complete, __flags, __arg, __arg_size));
+      if (rc == -1) {
+        return -errno;
+      } else {
+        return rc;
+      }
+    }
+
+    inline auto __io_uring_register(
+      int __ring_fd,
+      unsigned int __opcode,
+      const void* __arg,
+      unsigned int __nr_args) -> int {
+      int rc = static_cast<int>(
+        ::syscall(__NR_io_uring_register, __ring_fd, __opcode, __arg, __nr_args));
       if (rc == -1) {
         return -errno;
       } else {
@@ -92,10 +152,59 @@ namespace exec {
       return memory_mapped_region{__ptr, __size};
     }
 
+    inline auto __make_setup_params(unsigned __flags) noexcept -> ::io_uring_params {
+      ::io_uring_params __setup{};
+      __setup.flags = __flags;
+      return __setup;
+    }
+
+    inline auto __make_setup_params(const io_uring_context_params& __params)
+      -> ::io_uring_params {
+      ::io_uring_params __setup = __make_setup_params(__params.flags);
+      if (__params.sqpoll) {
+        __setup.flags |= IORING_SETUP_SQPOLL;
+        __setup.sq_thread_idle = static_cast<__u32>(__params.sq_thread_idle.count());
+        if (__params.sq_thread_cpu >= 0) {
+          __setup.flags |= IORING_SETUP_SQ_AFF;
+          __setup.sq_thread_cpu = static_cast<__u32>(__params.sq_thread_cpu);
+        }
+      }
+#    ifdef IORING_SETUP_SINGLE_ISSUER
+      if (__params.single_issuer) {
+        __setup.flags |= IORING_SETUP_SINGLE_ISSUER;
+      }
+#    else
+      __throw_error_code_if(__params.single_issuer, EINVAL);
+#    endif
+#    ifdef IORING_SETUP_DEFER_TASKRUN
+      if (__params.defer_taskrun) {
+        __setup.flags |= IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+      }
+#    else
+      __throw_error_code_if(__params.defer_taskrun, EINVAL);
+#    endif
+      return __setup;
+    }
+
+    // A single issuer ring belongs to the thread that enables it. We create it disabled
+    // and enable it on the thread that drives the context.
+    inline auto __with_deferred_enable(::io_uring_params __setup) noexcept -> ::io_uring_params {
+#    ifdef IORING_SETUP_SINGLE_ISSUER
+      if (__setup.flags & IORING_SETUP_SINGLE_ISSUER) {
+        __setup.flags |= IORING_SETUP_R_DISABLED;
+      }
+#    endif
+      return __setup;
+    }
+
     // This base class maps the kernel's io_uring data structures into the process.
     struct __context_base : stdexec::__immovable {
       explicit __context_base(unsigned __entries, unsigned __flags = 0)
-        : __params_{.flags = __flags}
+        : __context_base(__entries, __make_setup_params(__flags)) {
+      }
+
+      explicit __context_base(unsigned __entries, const ::io_uring_params& __setup)
+        : __params_{__with_deferred_enable(__setup)}
         , __ring_fd_{__io_uring_setup(__entries, __params_)}
         , __eventfd_{::eventfd(0, EFD_CLOEXEC)} {
         __throw_error_code_if(!__eventfd_, errno);
@@ -140,6 +249,10 @@ namespace exec {
       // This function is called when the io operation is completed.
       // The status of the operation is passed as a parameter.
       void (*__complete_)(__task*, const ::io_uring_cqe&) noexcept;
+      // The number of consecutive submission queue entries the task occupies.
+      // A task with more than one entry gets __submit_ called once per entry, in order, and
+      // receives one completion per entry. Its entries are always submitted together.
+      __u32 __n_sqes_{1};
     };
 
     // This is the base class for all io operations.
@@ -178,6 +291,7 @@ namespace exec {
     class __submission_queue {
       __atomic_ref<__u32> __head_;
       __atomic_ref<__u32> __tail_;
+      __atomic_ref<__u32> __flags_;
       __u32* __array_;
       ::io_uring_sqe* __entries_;
       __u32 __mask_;
@@ -189,12 +303,22 @@ namespace exec {
         const ::io_uring_params& __params)
         : __head_{*__at_offset_as<__u32*>(__region.data(), __params.sq_off.head)}
         , __tail_{*__at_offset_as<__u32*>(__region.data(), __params.sq_off.tail)}
+        , __flags_{*__at_offset_as<__u32*>(__region.data(), __params.sq_off.flags)}
         , __array_{__at_offset_as<__u32*>(__region.data(), __params.sq_off.array)}
         , __entries_{static_cast<::io_uring_sqe*>(__sqes_region.data())}
         , __mask_{*__at_offset_as<__u32*>(__region.data(), __params.sq_off.ring_mask)}
         , __n_total_slots_{__params.sq_entries} {
       }
 
+      // Returns true if the kernel's submission queue polling thread went to sleep and
+      // needs to be woken up with IORING_ENTER_SQ_WAKEUP.
+      [[nodiscard]]
+      auto needs_wakeup() const noexcept -> bool {
+        // The tail store must be visible before we read the flags that the kernel thread sets.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return __flags_.load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP;
+      }
+
       // This function submits the given queue of tasks to the io_uring.
       //
       // Each task that is ready to be completed is moved to the __ready queue.
@@ -219,6 +343,24 @@ namespace exec {
           STDEXEC_ASSERT(__op->__vtable_);
           if (__op->__vtable_->__ready_(__op)) {
             __result.__ready.push_back(__op);
+          } else if (const __u32 __n_sqes = __op->__vtable_->__n_sqes_; __n_sqes > 1) {
+            // Linked entries must not be split across two submissions.
+            if (__is_stopped) {
+              __stop(__op);
+            } else if (__max_submissions - __result.__n_submitted < __n_sqes) {
+              __tasks.push_front(__op);
+              break;
+            } else {
+              for (__u32 __i = 0; __i < __n_sqes; ++__i) {
+                const __u32 __link_index = __tail & __mask_;
+                ::io_uring_sqe& __link_sqe = __entries_[__link_index];
+                __op->__vtable_->__submit_(__op, __link_sqe);
+                __link_sqe.user_data = bit_cast<__u64>(__op);
+                __array_[__link_index] = __link_index;
+                ++__tail;
+              }
+              __result.__n_submitted += __n_sqes;
+            }
           } else {
             __op->__vtable_->__submit_(__op, __sqe);
 #    ifdef STDEXEC_HAS_IO_URING_ASYNC_CANCELLATION
@@ -236,14 +378,9 @@ namespace exec {
           }
         }
         __tail_.store(__tail, std::memory_order_release);
-        while (!__tasks.empty()) {
-          __op = __tasks.pop_front();
-          if (__op->__vtable_->__ready_(__op)) {
-            __result.__ready.push_back(__op);
-          } else {
-            __result.__pending.push_back(__op);
-          }
-        }
+        // The context sorts out ready tasks when it takes them from its request queue, so the
+        // rest of the backlog goes back as it is.
+        __result.__pending.append(static_cast<__task_queue&&>(__tasks));
         return __result;
       }
     };
@@ -253,6 +390,7 @@ namespace exec {
       __atomic_ref<__u32> __tail_;
       ::io_uring_cqe* __entries_;
       __u32 __mask_;
+      __u32 __max_per_pass_{std::numeric_limits<__u32>::max()};
      public:
       explicit __completion_queue(
         const memory_mapped_region& __region,
@@ -263,22 +401,48 @@ namespace exec {
         , __mask_{*__at_offset_as<__u32*>(__region.data(), __params.cq_off.ring_mask)} {
       }
 
+      [[nodiscard]]
+      auto has_completions() const noexcept -> bool {
+        return __tail_.load(std::memory_order_acquire) != __head_.load(std::memory_order_relaxed);
+      }
+
+      // Limits the number of cqes that one call to complete() handles, so that a busy ring
+      // cannot starve the submission side. Zero means no limit.
+      void set_max_completions_per_pass(__u32 __max_completions) noexcept {
+        __max_per_pass_ = __max_completions ? __max_completions : std::numeric_limits<__u32>::max();
+      }
+
       // This function first completes all tasks that are ready in the completion queue of the io_uring.
       // Then it completes all tasks that are ready in the given queue of ready tasks.
       // The function returns the number of previously submitted completed tasks.
+      //
+      // The completion queue is drained in one batch: the tail is read once, and the head is
+      // published once after the whole batch. Cqes that arrive in the meantime are left for
+      // the next call.
       auto complete(stdexec::__intrusive_queue<&__task::__next_> __ready = __task_queue{}) noexcept
         -> int {
         __u32 __head = __head_.load(std::memory_order_relaxed);
-        __u32 __tail = __tail_.load(std::memory_order_acquire);
+        const __u32 __tail = __tail_.load(std::memory_order_acquire);
+        const __u32 __end = __head + std::min(__tail - __head, __max_per_pass_);
         int __count = 0;
-        while (__head != __tail) {
-          const __u32 __index = __head & __mask_;
-          const ::io_uring_cqe& __cqe = __entries_[__index];
+        while (__head != __end) {
+          const ::io_uring_cqe& __cqe = __entries_[__head & __mask_];
+          ++__head;
+#    if STDEXEC_GCC() || STDEXEC_CLANG()
+          if (__head != __end) {
+            // Hide the cache miss on the next task's vtable pointer behind this completion.
+            __builtin_prefetch(bit_cast<const void*>(__entries_[__head & __mask_].user_data));
+          }
+#    endif
           auto* __op = bit_cast<__task*>(__cqe.user_data);
+#    ifdef STDEXEC_HAS_IO_URING_MULTISHOT
+          // A multishot request stays submitted until its last cqe.
+          const bool __is_last = !(__cqe.flags & IORING_CQE_F_MORE);
+#    else
+          const bool __is_last = true;
+#    endif
           __op->__vtable_->__complete_(__op, __cqe);
-          ++__head;
-          ++__count;
-          __tail = __tail_.load(std::memory_order_acquire);
+          __count += __is_last;
         }
         __head_.store(__head, std::memory_order_release);
         while (!__ready.empty()) {
@@ -290,6 +454,188 @@ namespace exec {
       }
     };
 
+    // A timer that lives in a __timer_wheel.
+    struct __wheel_timer {
+      __wheel_timer* __timer_prev_{nullptr};
+      __wheel_timer* __timer_next_{nullptr};
+      std::uint64_t __deadline_tick_{0};
+      std::uint8_t __level_{0};
+      std::uint8_t __slot_{0};
+      // Called when the timer is due. The timer has already been removed from the wheel.
+      void (*__expire_)(__wheel_timer*) noexcept;
+
+      explicit __wheel_timer(void (*__expire)(__wheel_timer*) noexcept) noexcept
+        : __expire_{__expire} {
+      }
+    };
+
+    // A hierarchical timing wheel with 64 slots per level. A timer is stored on the level of
+    // the highest bit in which its deadline differs from the current tick. When the wheel
+    // reaches a slot of a higher level, its timers are moved down to the lower levels.
+    // Insertion and removal are O(1), and finding the next expiry looks at one bit mask per
+    // level.
+    //
+    // The wheel is not thread-safe and is only used by the thread that drives the context.
+    class __timer_wheel {
+      static constexpr int __slot_bits = 6;
+      static constexpr int __n_slots = 1 << __slot_bits;
+      static constexpr int __n_levels = 6;
+
+      struct __level {
+        std::uint64_t __occupied_{0};
+        std::array<__wheel_timer*, __n_slots> __slots_{};
+      };
+
+      struct __slot_ref {
+        int __level_;
+        int __slot_;
+        std::uint64_t __start_tick_;
+      };
+
+      std::chrono::nanoseconds __resolution_;
+      std::chrono::steady_clock::time_point __origin_;
+      std::uint64_t __elapsed_{0};
+      std::size_t __n_timers_{0};
+      std::array<__level, __n_levels> __levels_{};
+
+      void __link(__wheel_timer* __timer) noexcept {
+        const std::uint64_t __masked = (__elapsed_ ^ __timer->__deadline_tick_) | (__n_slots - 1);
+        const int __level = std::min(
+          (static_cast<int>(std::bit_width(__masked)) - 1) / __slot_bits, __n_levels - 1);
+        const int __slot =
+          static_cast<int>((__timer->__deadline_tick_ >> (__level * __slot_bits)) & (__n_slots - 1));
+        __wheel_timer*& __head = __levels_[__level].__slots_[__slot];
+        __timer->__level_ = static_cast<std::uint8_t>(__level);
+        __timer->__slot_ = static_cast<std::uint8_t>(__slot);
+        __timer->__timer_prev_ = nullptr;
+        __timer->__timer_next_ = __head;
+        if (__head) {
+          __head->__timer_prev_ = __timer;
+        }
+        __head = __timer;
+        __levels_[__level].__occupied_ |= std::uint64_t{1} << __slot;
+      }
+
+      // Finds the occupied slot that the wheel reaches first.
+      auto __next_slot() const noexcept -> std::optional<__slot_ref> {
+        std::optional<__slot_ref> __next{};
+        for (int __level = 0; __level < __n_levels; ++__level) {
+          const std::uint64_t __occupied = __levels_[__level].__occupied_;
+          if (__occupied == 0) {
+            continue;
+          }
+          const int __shift = __level * __slot_bits;
+          const int __current = static_cast<int>((__elapsed_ >> __shift) & (__n_slots - 1));
+          const int __slot = (std::countr_zero(std::rotr(__occupied, __current)) + __current)
+                           & (__n_slots - 1);
+          const std::uint64_t __level_range = std::uint64_t{1} << (__shift + __slot_bits);
+          std::uint64_t __start = (__elapsed_ & ~(__level_range - 1))
+                                + (static_cast<std::uint64_t>(__slot) << __shift);
+          if (__start <= __elapsed_) {
+            // Only timers beyond the range of the top level can wrap around.
+            __start += __level_range;
+          }
+          if (!__next || __start < __next->__start_tick_) {
+            __next = __slot_ref{__level, __slot, __start};
+          }
+        }
+        return __next;
+      }
+
+      auto __take(int __level, int __slot) noexcept -> __wheel_timer* {
+        __wheel_timer* __list = std::exchange(__levels_[__level].__slots_[__slot], nullptr);
+        __levels_[__level].__occupied_ &= ~(std::uint64_t{1} << __slot);
+        return __list;
+      }
+
+     public:
+      explicit __timer_wheel(std::chrono::nanoseconds __resolution) noexcept
+        : __resolution_{std::max(__resolution, std::chrono::nanoseconds{1})}
+        , __origin_{std::chrono::steady_clock::now()} {
+      }
+
+      [[nodiscard]]
+      auto empty() const noexcept -> bool {
+        return __n_timers_ == 0;
+      }
+
+      // Adds a timer that expires at __deadline. A timer that is already due expires inline.
+      void insert(__wheel_timer* __timer, std::chrono::steady_clock::time_point __deadline) noexcept {
+        const auto __ticks = (__deadline - __origin_ + __resolution_ - std::chrono::nanoseconds{1})
+                           / __resolution_;
+        __timer->__deadline_tick_ = static_cast<std::uint64_t>(std::max<std::int64_t>(__ticks, 0));
+        if (__timer->__deadline_tick_ <= __elapsed_) {
+          __timer->__expire_(__timer);
+        } else {
+          __link(__timer);
+          ++__n_timers_;
+        }
+      }
+
+      void erase(__wheel_timer* __timer) noexcept {
+        if (__timer->__timer_prev_) {
+          __timer->__timer_prev_->__timer_next_ = __timer->__timer_next_;
+        } else {
+          __levels_[__timer->__level_].__slots_[__timer->__slot_] = __timer->__timer_next_;
+          if (!__timer->__timer_next_) {
+            __levels_[__timer->__level_].__occupied_ &= ~(std::uint64_t{1} << __timer->__slot_);
+          }
+        }
+        if (__timer->__timer_next_) {
+          __timer->__timer_next_->__timer_prev_ = __timer->__timer_prev_;
+        }
+        --__n_timers_;
+      }
+
+      // Returns the point in time when the next timer is due.
+      [[nodiscard]]
+      auto next_expiry() const noexcept -> std::optional<std::chrono::steady_clock::time_point> {
+        if (auto __next = __next_slot()) {
+          return __origin_ + __resolution_ * static_cast<std::int64_t>(__next->__start_tick_);
+        }
+        return std::nullopt;
+      }
+
+      // Expires all timers that are due at __now.
+      void advance(std::chrono::steady_clock::time_point __now) noexcept {
+        const auto __now_tick = static_cast<std::uint64_t>(
+          std::max<std::int64_t>((__now - __origin_) / __resolution_, 0));
+        while (__n_timers_ > 0) {
+          std::optional<__slot_ref> __next = __next_slot();
+          if (__next->__start_tick_ > __now_tick) {
+            break;
+          }
+          __elapsed_ = __next->__start_tick_;
+          __wheel_timer* __list = __take(__next->__level_, __next->__slot_);
+          while (__list) {
+            __wheel_timer* __timer = std::exchange(__list, __list->__timer_next_);
+            if (__timer->__deadline_tick_ <= __elapsed_) {
+              --__n_timers_;
+              __timer->__expire_(__timer);
+            } else {
+              __link(__timer);
+            }
+          }
+        }
+        __elapsed_ = std::max(__elapsed_, __now_tick);
+      }
+
+      // Expires all timers regardless of their deadline.
+      void expire_all() noexcept {
+        for (int __level = 0; __level < __n_levels; ++__level) {
+          while (__levels_[__level].__occupied_) {
+            const int __slot = std::countr_zero(__levels_[__level].__occupied_);
+            __wheel_timer* __list = __take(__level, __slot);
+            while (__list) {
+              __wheel_timer* __timer = std::exchange(__list, __list->__timer_next_);
+              --__n_timers_;
+              __timer->__expire_(__timer);
+            }
+          }
+        }
+      }
+    };
+
     class __context;
 
     struct __wakeup_operation : __task {
@@ -346,7 +692,28 @@ namespace exec {
     class __context : __context_base {
      public:
       explicit __context(unsigned __entries = 1024, unsigned __flags = 0)
-        : __context_base(std::max(__entries, 2u), __flags)
+        : __context(__entries, __make_setup_params(__flags)) {
+      }
+
+      /// @brief Creates an io context with the given ring configuration.
+      ///
+      /// For single issuer rings, every run of the context has to happen on the same thread.
+      /// Buffers have to be registered before the first run or from within the driving thread.
+      explicit __context(const io_uring_context_params& __params)
+        : __context(__params.entries, __make_setup_params(__params)) {
+        __completion_queue_.set_max_completions_per_pass(__params.max_completions_per_pass);
+        if (__params.timer_wheel) {
+#    ifdef IORING_FEAT_EXT_ARG
+          __throw_error_code_if(!(__params_.features & IORING_FEAT_EXT_ARG), EINVAL);
+          __timer_wheel_.emplace(__params.timer_wheel_resolution);
+#    else
+          __throw_error_code_if(true, EINVAL);
+#    endif
+        }
+      }
+
+      explicit __context(unsigned __entries, const ::io_uring_params& __setup)
+        : __context_base(std::max(__entries, 2u), __setup)
         , __completion_queue_{__completion_queue_region_ ? __completion_queue_region_ : __submission_queue_region_, __params_}
         , __submission_queue_{__submission_queue_region_, __submission_queue_entries_, __params_}
         , __wakeup_operation_{this, __eventfd_} {
@@ -384,6 +751,58 @@ namespace exec {
         return __is_running_.load(std::memory_order_relaxed);
       }
 
+      /// @brief Returns true if schedule_after timers are kept in a timing wheel.
+      auto has_timer_wheel() const noexcept -> bool {
+        return __timer_wheel_.has_value();
+      }
+
+      /// @brief Returns the number of requests that can be in flight at once.
+      auto max_in_flight() const noexcept -> std::size_t {
+        return std::min(__params_.sq_entries, __params_.cq_entries);
+      }
+
+      /// @brief Registers fixed buffers with the kernel.
+      ///
+      /// The pages backing the buffers are pinned once, and fixed reads and writes
+      /// refer to a buffer by its index into `__buffers`. The buffers must stay
+      /// valid until they are unregistered or the context is destroyed.
+      void register_buffers(std::span<const ::iovec> __buffers) {
+        int __rc = __io_uring_register(
+          __ring_fd_,
+          IORING_REGISTER_BUFFERS,
+          __buffers.data(),
+          static_cast<unsigned>(__buffers.size()));
+        __throw_error_code_if(__rc < 0, -__rc);
+      }
+
+      /// @brief Unregisters all buffers previously registered with register_buffers().
+      void unregister_buffers() {
+        int __rc = __io_uring_register(__ring_fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        __throw_error_code_if(__rc < 0, -__rc);
+      }
+
+#    ifdef STDEXEC_HAS_IO_URING_MULTISHOT
+      /// @brief Registers a ring of provided buffers for the buffer group `__group_id`.
+      ///
+      /// `__ring` must point to page aligned memory for `__n_entries` io_uring_buf entries.
+      void register_buffer_ring(void* __ring, unsigned __n_entries, __u16 __group_id) {
+        ::io_uring_buf_reg __reg{};
+        __reg.ring_addr = bit_cast<__u64>(__ring);
+        __reg.ring_entries = __n_entries;
+        __reg.bgid = __group_id;
+        int __rc = __io_uring_register(__ring_fd_, IORING_REGISTER_PBUF_RING, &__reg, 1);
+        __throw_error_code_if(__rc < 0, -__rc);
+      }
+
+      /// @brief Unregisters the provided buffer ring of the buffer group `__group_id`.
+      void unregister_buffer_ring(__u16 __group_id) {
+        ::io_uring_buf_reg __reg{};
+        __reg.bgid = __group_id;
+        int __rc = __io_uring_register(__ring_fd_, IORING_UNREGISTER_PBUF_RING, &__reg, 1);
+        __throw_error_code_if(__rc < 0, -__rc);
+      }
+#    endif
+
       /// @brief  Breaks out of the run loop of the io context without stopping the context.
       void finish() {
         __break_loop_.store(true, std::memory_order_release);
@@ -425,7 +844,7 @@ namespace exec {
           0 <= __n_total_submitted_
           && __n_total_submitted_ <= static_cast<std::ptrdiff_t>(__params_.cq_entries));
         __u32 __max_submissions = __params_.cq_entries - static_cast<__u32>(__n_total_submitted_);
-        __pending_.append(__requests_.pop_all_reversed());
+        __drain_requests();
         __submission_result __result = __submission_queue_.submit(
           static_cast<__task_queue&&>(__pending_),
           __max_submissions,
@@ -434,11 +853,12 @@ namespace exec {
         __n_newly_submitted_ += __result.__n_submitted;
         STDEXEC_ASSERT(__n_total_submitted_ <= static_cast<std::ptrdiff_t>(__params_.cq_entries));
         __pending_ = static_cast<__task_queue&&>(__result.__pending);
+        __result.__ready.append(static_cast<__task_queue&&>(__ready_tasks_));
         while (!__result.__ready.empty()) {
           __n_total_submitted_ -= __completion_queue_.complete(
             static_cast<__task_queue&&>(__result.__ready));
           STDEXEC_ASSERT(0 <= __n_total_submitted_);
-          __pending_.append(__requests_.pop_all_reversed());
+          __drain_requests();
           __max_submissions = __params_.cq_entries - static_cast<__u32>(__n_total_submitted_);
           __result = __submission_queue_.submit(
             static_cast<__task_queue&&>(__pending_),
@@ -448,6 +868,21 @@ namespace exec {
           __n_newly_submitted_ += __result.__n_submitted;
           STDEXEC_ASSERT(__n_total_submitted_ <= static_cast<std::ptrdiff_t>(__params_.cq_entries));
           __pending_ = static_cast<__task_queue&&>(__result.__pending);
+          __result.__ready.append(static_cast<__task_queue&&>(__ready_tasks_));
+        }
+      }
+
+      // Moves new requests to __pending_, except for those that are ready to complete. They go
+      // to __ready_tasks_, so that they never wait for room in the rings behind pending io.
+      void __drain_requests() noexcept {
+        __task_queue __requests = __requests_.pop_all_reversed();
+        while (!__requests.empty()) {
+          __task* __op = __requests.pop_front();
+          if (__op->__vtable_->__ready_(__op)) {
+            __ready_tasks_.push_back(__op);
+          } else {
+            __pending_.push_back(__op);
+          }
         }
       }
 
@@ -473,12 +908,21 @@ namespace exec {
         scope_guard __not_running{[&]() noexcept {
           __is_running_.store(false, std::memory_order_relaxed);
         }};
-        __pending_.append(__requests_.pop_all_reversed());
-        while (__n_total_submitted_ > 0 || !__pending_.empty()) {
+#    ifdef IORING_SETUP_SINGLE_ISSUER
+        if (__params_.flags & IORING_SETUP_R_DISABLED) {
+          int __rc = __io_uring_register(__ring_fd_, IORING_REGISTER_ENABLE_RINGS, nullptr, 0);
+          __throw_error_code_if(__rc < 0, -__rc);
+          __params_.flags &= ~IORING_SETUP_R_DISABLED;
+        }
+#    endif
+        __drain_requests();
+        while (__n_total_submitted_ > 0 || !__pending_.empty() || !__ready_tasks_.empty()) {
+          __run_timers();
           run_some();
           if (
             __n_total_submitted_ == 0
-            || (__n_total_submitted_ == 1 && __break_loop_.load(std::memory_order_acquire))) {
+            || (__n_total_submitted_ == 1 && __break_loop_.load(std::memory_order_acquire)
+                && !__has_timers())) {
             __break_loop_.store(false, std::memory_order_relaxed);
             break;
           }
@@ -486,20 +930,56 @@ namespace exec {
           STDEXEC_ASSERT(
             0 <= __n_total_submitted_
             && __n_total_submitted_ <= static_cast<std::ptrdiff_t>(__params_.cq_entries));
-          int rc = __io_uring_enter(
-            __ring_fd_, __n_newly_submitted_, __min_complete, IORING_ENTER_GETEVENTS);
-          __throw_error_code_if(rc < 0 && rc != -EINTR, -rc);
-          if (rc != -EINTR) {
+          unsigned __enter_flags = IORING_ENTER_GETEVENTS;
+          if (__params_.flags & IORING_SETUP_SQPOLL) {
+            // The kernel thread consumes the submission queue on its own. We only need
+            // a system call to wake it up or to wait for completions.
+            __n_newly_submitted_ = 0;
+            if (__submission_queue_.needs_wakeup()) {
+              __enter_flags |= IORING_ENTER_SQ_WAKEUP;
+            } else if (__completion_queue_.has_completions()) {
+              __n_total_submitted_ -= __completion_queue_.complete();
+              STDEXEC_ASSERT(0 <= __n_total_submitted_);
+              __drain_requests();
+              continue;
+            }
+          }
+          int rc = 0;
+#    ifdef IORING_FEAT_EXT_ARG
+          if (__has_timers()) {
+            // Wait for completions at most until the next timer is due.
+            auto __timeout = std::max(
+              std::chrono::nanoseconds{*__timer_wheel_->next_expiry() - std::chrono::steady_clock::now()},
+              std::chrono::nanoseconds{0});
+            auto __secs = std::chrono::duration_cast<std::chrono::seconds>(__timeout);
+            ::__kernel_timespec __ts{.tv_sec = __secs.count(), .tv_nsec = (__timeout - __secs).count()};
+            ::io_uring_getevents_arg __arg{};
+            __arg.ts = bit_cast<__u64>(&__ts);
+            rc = __io_uring_enter(
+              __ring_fd_,
+              __n_newly_submitted_,
+              __min_complete,
+              __enter_flags | IORING_ENTER_EXT_ARG,
+              &__arg,
+              sizeof(__arg));
+          } else
+#    endif
+          {
+            rc = __io_uring_enter(__ring_fd_, __n_newly_submitted_, __min_complete, __enter_flags);
+          }
+          __throw_error_code_if(rc < 0 && rc != -EINTR && rc != -ETIME, -rc);
+          if (rc >= 0) {
             STDEXEC_ASSERT(rc <= __n_newly_submitted_);
             __n_newly_submitted_ -= rc;
           }
           __n_total_submitted_ -= __completion_queue_.complete();
           STDEXEC_ASSERT(0 <= __n_total_submitted_);
-          __pending_.append(__requests_.pop_all_reversed());
+          __drain_requests();
         }
         STDEXEC_ASSERT(__n_total_submitted_ <= 1);
-        if (__stop_source_->stop_requested() && __pending_.empty()) {
+        if (__stop_source_->stop_requested() && __pending_.empty() && __ready_tasks_.empty()) {
           STDEXEC_ASSERT(__n_total_submitted_ == 0);
+          __run_timers();
           // try to shutdown the request queue
           int __n_in_flight_expected = 0;
           while (!__n_submissions_in_flight_.compare_exchange_weak(
@@ -513,11 +993,12 @@ namespace exec {
             __n_submissions_in_flight_.load(std::memory_order_relaxed) == __no_new_submissions);
           // There could have been requests in flight. Complete all of them
           // and then stop it, finally.
-          __pending_.append(__requests_.pop_all_reversed());
+          __drain_requests();
           __submission_result __result = __submission_queue_.submit(
             static_cast<__task_queue&&>(__pending_), __params_.cq_entries, true);
           STDEXEC_ASSERT(__result.__n_submitted == 0);
           STDEXEC_ASSERT(__result.__pending.empty());
+          __result.__ready.append(static_cast<__task_queue&&>(__ready_tasks_));
           __completion_queue_.complete(static_cast<__task_queue&&>(__result.__ready));
         }
       }
@@ -606,6 +1087,24 @@ namespace exec {
      private:
       friend struct __wakeup_operation;
 
+      template <class>
+      friend struct __wheel_timer_operation;
+
+      auto __has_timers() const noexcept -> bool {
+        return __timer_wheel_ && !__timer_wheel_->empty();
+      }
+
+      // Expires the timers that are due, or all of them once the context is stopped.
+      void __run_timers() noexcept {
+        if (__has_timers()) {
+          if (__stop_source_->stop_requested()) {
+            __timer_wheel_->expire_all();
+          } else {
+            __timer_wheel_->advance(std::chrono::steady_clock::now());
+          }
+        }
+      }
+
       // This constant is used for __n_submissions_in_flight to indicate that no new submissions
       // to this context will be completed by this context.
       static constexpr int __no_new_submissions = -1;
@@ -619,8 +1118,11 @@ namespace exec {
       __completion_queue __completion_queue_;
       __submission_queue __submission_queue_;
       __task_queue __pending_{};
+      // Requests that were ready to complete when they were taken from __requests_.
+      __task_queue __ready_tasks_{};
       __atomic_task_queue __requests_{};
       __wakeup_operation __wakeup_operation_;
+      std::optional<__timer_wheel> __timer_wheel_{};
     };
 
     inline void __wakeup_operation::start() noexcept {
@@ -1047,112 +1549,592 @@ namespace exec {
       using __t = __stoppable_task_facade_t<__impl>;
     };
 
-    class __scheduler {
-     public:
-      __context* __context_;
-
-      friend auto operator==(const __scheduler& __lhs, const __scheduler& __rhs) -> bool = default;
+    // Keeps the timer in the context's timing wheel instead of submitting an IORING_OP_TIMEOUT.
+    // The operation enters the context as a ready task to insert the timer on the thread that
+    // drives the context. A stop request submits it once more to take the timer out again.
+    template <class _ReceiverId>
+    struct __wheel_timer_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
 
-      class __schedule_env {
+      class __t
+        : public __task
+        , public __wheel_timer {
        public:
-        __context* __context_;
-       private:
-        friend auto tag_invoke(
-          stdexec::get_completion_scheduler_t<stdexec::set_value_t>,
-          const __schedule_env& __env) noexcept -> __scheduler {
-          return __scheduler{__env.__context_};
+        static auto __ready_(__task*) noexcept -> bool {
+          return true;
         }
-      };
 
-      class __schedule_sender {
-        __schedule_env __env_;
-       public:
-        using sender_concept = stdexec::sender_t;
-        using __id = __schedule_sender;
-        using __t = __schedule_sender;
+        static void __submit_(__task*, ::io_uring_sqe&) noexcept {
+        }
 
-        explicit __schedule_sender(__schedule_env __env) noexcept
-          : __env_{__env} {
+        static void __complete_(__task* __pointer, const ::io_uring_cqe& __cqe) noexcept {
+          auto* __self = static_cast<__t*>(__pointer);
+          if (!__self->__registered_ && __cqe.res != -ECANCELED) {
+            __self->__register();
+          } else {
+            __self->__cancel();
+          }
         }
 
-       private:
-        friend auto tag_invoke(stdexec::get_env_t, const __schedule_sender& __sender) noexcept
-          -> __schedule_env {
-          return __sender.__env_;
+        static void __on_expire_(__wheel_timer* __pointer) noexcept {
+          auto* __self = static_cast<__t*>(__pointer);
+          __self->__in_wheel_ = false;
+          // Resetting the callback waits for a callback running on another thread.
+          __self->__on_receiver_stop_.reset();
+          if (__self->__stop_requested_.load(std::memory_order_acquire)) {
+            // The stop callback has submitted this operation again. It completes from there.
+            return;
+          }
+          if (__self->__context_.stop_requested()) {
+            stdexec::set_stopped(static_cast<_Receiver&&>(__self->__receiver_));
+          } else {
+            stdexec::set_value(static_cast<_Receiver&&>(__self->__receiver_));
+          }
         }
 
-        using __completion_sigs =
-          stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_stopped_t()>;
+        static constexpr __task_vtable __vtable{&__ready_, &__submit_, &__complete_};
 
-        template <class _Env>
-        friend auto
-          tag_invoke(stdexec::get_completion_signatures_t, const __schedule_sender&, _Env) noexcept
-          -> __completion_sigs {
-          return {};
+        __t(__context& __context, std::chrono::nanoseconds __duration, _Receiver&& __receiver)
+          : __task{__vtable}
+          , __wheel_timer{&__on_expire_}
+          , __context_{__context}
+          , __receiver_{static_cast<_Receiver&&>(__receiver)}
+          , __duration_{__duration} {
         }
 
-        template <typename _Receiver, std::enable_if_t<stdexec::receiver_of<_Receiver, __completion_sigs>, int> = 0>
-        friend auto
-          tag_invoke(stdexec::connect_t, const __schedule_sender& __sender, _Receiver&& __receiver)
-            -> stdexec::__t<__schedule_operation<stdexec::__id<_Receiver>>> {
-          return stdexec::__t<__schedule_operation<stdexec::__id<_Receiver>>>(
-            std::in_place, *__sender.__env_.__context_, static_cast<_Receiver&&>(__receiver));
-        }
-      };
+       private:
+        struct __stop_callback {
+          __t* __self_;
 
-      class __schedule_after_sender {
-       public:
-        using sender_concept = stdexec::sender_t;
-        using __id = __schedule_after_sender;
-        using __t = __schedule_after_sender;
+          void operator()() noexcept {
+            __self_->__stop_requested_.store(true, std::memory_order_release);
+            if (__self_->__context_.submit(__self_)) {
+              __self_->__context_.wakeup();
+            }
+          }
+        };
 
-        __schedule_env __env_;
+        using __on_receiver_stop_t = std::optional<typename stdexec::stop_token_of_t<
+          stdexec::env_of_t<_Receiver>&>::template callback_type<__stop_callback>>;
+
+        __context& __context_;
+        _Receiver __receiver_;
         std::chrono::nanoseconds __duration_;
+        std::chrono::steady_clock::time_point __deadline_{};
+        // Only accessed on the context's thread.
+        bool __registered_{false};
+        bool __in_wheel_{false};
+        std::atomic<bool> __stop_requested_{false};
+        __on_receiver_stop_t __on_receiver_stop_{};
 
-       private:
-        friend auto tag_invoke(stdexec::get_env_t, const __schedule_after_sender& __sender) noexcept
-          -> __schedule_env {
-          return __sender.__env_;
+        void __register() noexcept {
+          __registered_ = true;
+          auto __token = stdexec::get_stop_token(stdexec::get_env(__receiver_));
+          if (__context_.stop_requested() || __token.stop_requested()) {
+            stdexec::set_stopped(static_cast<_Receiver&&>(__receiver_));
+            return;
+          }
+          __on_receiver_stop_.emplace(__token, __stop_callback{this});
+          __in_wheel_ = true;
+          __context_.__timer_wheel_->insert(this, __deadline_);
         }
 
-        using __completion_sigs = stdexec::completion_signatures<
-          stdexec::set_value_t(),
-          stdexec::set_error_t(std::exception_ptr),
-          stdexec::set_stopped_t()>;
-
-        template <class _Env>
-        friend auto tag_invoke(
-          stdexec::get_completion_signatures_t,
-          const __schedule_after_sender&,
-          _Env) noexcept -> __completion_sigs {
-          return {};
+        void __cancel() noexcept {
+          if (__in_wheel_) {
+            __context_.__timer_wheel_->erase(this);
+            __in_wheel_ = false;
+          }
+          __on_receiver_stop_.reset();
+          stdexec::set_stopped(static_cast<_Receiver&&>(__receiver_));
         }
 
-        template <typename _Receiver, std::enable_if_t<stdexec::receiver_of<_Receiver, __completion_sigs>, int> = 0>
-        friend auto tag_invoke(
-          stdexec::connect_t,
-          const __schedule_after_sender& __sender,
-          _Receiver&& __receiver)
-          -> stdexec::__t<__schedule_after_operation<stdexec::__id<_Receiver>>> {
-          return stdexec::__t<__schedule_after_operation<stdexec::__id<_Receiver>>>(
-            std::in_place,
-            *__sender.__env_.__context_,
-            __sender.__duration_,
-            static_cast<_Receiver&&>(__receiver));
+        friend void tag_invoke(stdexec::start_t, __t& __self) noexcept {
+          __self.__deadline_ = std::chrono::steady_clock::now() + __self.__duration_;
+          if (__self.__context_.submit(&__self)) {
+            __self.__context_.wakeup();
+          }
         }
       };
+    };
 
-     private:
-      friend auto tag_invoke(stdexec::schedule_t, const __scheduler& __sched) -> __schedule_sender {
-        return __schedule_sender{__schedule_env{__sched.__context_}};
-      }
+    // Uses the timing wheel if the context has one and a kernel timeout otherwise.
+    template <class _ReceiverId>
+    struct __timer_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __kernel_op_t = stdexec::__t<__schedule_after_operation<_ReceiverId>>;
+      using __wheel_op_t = stdexec::__t<__wheel_timer_operation<_ReceiverId>>;
 
-      friend auto tag_invoke(exec::now_t, const __scheduler& __sched) noexcept
-        -> std::chrono::time_point<std::chrono::steady_clock> {
-        return std::chrono::steady_clock::now();
-      }
+      class __t {
+        std::variant<std::monostate, __kernel_op_t, __wheel_op_t> __op_{};
 
-      friend auto tag_invoke(
+        friend void tag_invoke(stdexec::start_t, __t& __self) noexcept {
+          if (auto* __wheel_op = std::get_if<__wheel_op_t>(&__self.__op_)) {
+            stdexec::start(*__wheel_op);
+          } else {
+            stdexec::start(std::get<__kernel_op_t>(__self.__op_));
+          }
+        }
+
+       public:
+        __t(__context& __context, std::chrono::nanoseconds __duration, _Receiver&& __receiver) {
+          if (__context.has_timer_wheel()) {
+            __op_.template emplace<__wheel_op_t>(
+              __context, __duration, static_cast<_Receiver&&>(__receiver));
+          } else {
+            __op_.template emplace<__kernel_op_t>(
+              std::in_place, __context, __duration, static_cast<_Receiver&&>(__receiver));
+          }
+        }
+      };
+    };
+
+#    ifdef STDEXEC_HAS_IORING_OP_READ
+    inline constexpr __u8 __read_opcode = IORING_OP_READ;
+    inline constexpr __u8 __write_opcode = IORING_OP_WRITE;
+#    else
+    // Older kernels do not know IORING_OP_READ and IORING_OP_WRITE.
+    // We issue a vectored operation with a single buffer instead.
+    inline constexpr __u8 __read_opcode = IORING_OP_READV;
+    inline constexpr __u8 __write_opcode = IORING_OP_WRITEV;
+#    endif
+
+    // Describes a single io request on a file descriptor.
+    // The fields mirror the io_uring_sqe layout.
+    // Any memory referenced by __addr_ or __off_ must stay valid until the operation completes.
+    struct __io_request {
+      __u8 __opcode_;
+      __u8 __sqe_flags_{0};
+      __u16 __ioprio_{0};
+      int __fd_;
+      __u64 __offset_{0};
+      __u64 __addr_{0};
+      __u32 __len_{0};
+      __u32 __op_flags_{0};
+      __u16 __buf_index_{0};
+#    ifndef STDEXEC_HAS_IORING_OP_READ
+      bool __single_buffer_{false};
+#    endif
+    };
+
+    inline auto __make_sqe(const __io_request& __request) noexcept -> ::io_uring_sqe {
+      ::io_uring_sqe __sqe{};
+      __sqe.opcode = __request.__opcode_;
+      __sqe.flags = __request.__sqe_flags_;
+      __sqe.ioprio = __request.__ioprio_;
+      __sqe.fd = __request.__fd_;
+      __sqe.off = __request.__offset_;
+      __sqe.addr = __request.__addr_;
+      __sqe.len = __request.__len_;
+      __sqe.rw_flags = __request.__op_flags_;
+      __sqe.buf_index = __request.__buf_index_;
+      return __sqe;
+    }
+
+    // Completes with the result of the cqe converted to _Value, or with no value if _Value is void.
+    template <class _ReceiverId, class _Value>
+    struct __io_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      class __impl : public __stoppable_op_base<_Receiver> {
+        __io_request __request_;
+#    ifndef STDEXEC_HAS_IORING_OP_READ
+        ::iovec __iov_{};
+#    endif
+
+       public:
+        static constexpr auto ready() noexcept -> std::false_type {
+          return {};
+        }
+
+        void submit(::io_uring_sqe& __sqe) noexcept {
+          __sqe = __make_sqe(__request_);
+#    ifndef STDEXEC_HAS_IORING_OP_READ
+          if (__request_.__single_buffer_) {
+            __sqe.addr = bit_cast<__u64>(&__iov_);
+            __sqe.len = 1;
+          }
+#    endif
+        }
+
+        void complete(const ::io_uring_cqe& __cqe) noexcept {
+          if (__cqe.res >= 0) {
+            if constexpr (std::is_void_v<_Value>) {
+              stdexec::set_value(static_cast<_Receiver&&>(this->__receiver_));
+            } else {
+              stdexec::set_value(
+                static_cast<_Receiver&&>(this->__receiver_), static_cast<_Value>(__cqe.res));
+            }
+          } else {
+            stdexec::set_error(
+              static_cast<_Receiver&&>(this->__receiver_),
+              std::make_exception_ptr(std::system_error(-__cqe.res, std::system_category())));
+          }
+        }
+
+        __impl(__context& __context, const __io_request& __request, _Receiver&& __receiver)
+          : __stoppable_op_base<_Receiver>{__context, static_cast<_Receiver&&>(__receiver)}
+          , __request_{__request}
+#    ifndef STDEXEC_HAS_IORING_OP_READ
+          , __iov_{bit_cast<void*>(__request.__addr_), __request.__len_}
+#    endif
+        {
+        }
+      };
+
+      using __t = __stoppable_task_facade_t<__impl>;
+    };
+
+#    ifdef STDEXEC_HAS_IO_URING_MULTISHOT
+    // A multishot request produces one cqe per item until the kernel clears IORING_CQE_F_MORE.
+    // Every item is forwarded as a `just(value)` sender to set_next of the sequence receiver.
+    // Items may run concurrently with each other; the sequence completes once the request has
+    // finished and all items have completed.
+    template <class _ReceiverId, class _Decoder>
+    struct __multishot_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using _Value = decltype(std::declval<const _Decoder&>()(std::declval<const ::io_uring_cqe&>()));
+      using _ItemSender = decltype(stdexec::just(std::declval<_Value>()));
+
+      class __t;
+
+      struct __item_slot;
+
+      struct __item_receiver {
+        using receiver_concept = stdexec::receiver_t;
+        using __id = __item_receiver;
+        using __t = __item_receiver;
+
+        typename __multishot_operation::__t* __op_;
+        __item_slot* __slot_;
+
+        friend void tag_invoke(stdexec::set_value_t, __item_receiver&& __self) noexcept {
+          __self.__op_->__item_completed(__self.__slot_, false);
+        }
+
+        friend void tag_invoke(stdexec::set_stopped_t, __item_receiver&& __self) noexcept {
+          __self.__op_->__item_completed(__self.__slot_, true);
+        }
+
+        friend auto tag_invoke(stdexec::get_env_t, const __item_receiver& __self) noexcept
+          -> stdexec::env_of_t<_Receiver> {
+          return stdexec::get_env(__self.__op_->__rcvr_);
+        }
+      };
+
+      using _NextSender = next_sender_of_t<_Receiver, _ItemSender>;
+
+      struct __item_operation {
+        stdexec::connect_result_t<_NextSender, __item_receiver> __op_;
+
+        __item_operation(
+          typename __multishot_operation::__t* __parent,
+          __item_slot* __slot,
+          _Value&& __value)
+          : __op_{stdexec::connect(
+            exec::set_next(__parent->__rcvr_, stdexec::just(static_cast<_Value&&>(__value))),
+            __item_receiver{__parent, __slot})} {
+        }
+      };
+
+      // Storage for one item. A completed item hands its slot back to the operation, which
+      // reuses it for a later cqe, so a stream allocates only as many items as run at once.
+      struct __item_slot {
+        __item_slot* __next_{nullptr};
+        alignas(__item_operation) unsigned char __storage_[sizeof(__item_operation)];
+
+        auto __item() noexcept -> __item_operation* {
+          return std::launder(reinterpret_cast<__item_operation*>(__storage_));
+        }
+      };
+
+      class __t : public __task {
+       public:
+        static auto __ready_(__task*) noexcept -> bool {
+          return false;
+        }
+
+        static void __submit_(__task* __pointer, ::io_uring_sqe& __sqe) noexcept {
+          auto* __self = static_cast<__t*>(__pointer);
+          __self->__on_context_stop_.emplace(
+            __self->__context_.get_stop_token(), __stop_callback{__self});
+          __self->__on_receiver_stop_.emplace(
+            stdexec::get_stop_token(stdexec::get_env(__self->__rcvr_)), __stop_callback{__self});
+          __sqe = __make_sqe(__self->__request_);
+        }
+
+        static void __complete_(__task* __pointer, const ::io_uring_cqe& __cqe) noexcept {
+          auto* __self = static_cast<__t*>(__pointer);
+          if (_Decoder::__has_value(__cqe)) {
+            __self->__start_item(__self->__decoder_(__cqe));
+          } else if (__cqe.res < 0 && __cqe.res != -ECANCELED) {
+            __self->__set_error(
+              std::make_exception_ptr(std::system_error(-__cqe.res, std::system_category())));
+          }
+          if (!(__cqe.flags & IORING_CQE_F_MORE)) {
+            // Resetting the callbacks waits for callbacks running on other threads.
+            // No more cancellations are requested after this point.
+            __self->__on_context_stop_.reset();
+            __self->__on_receiver_stop_.reset();
+            __self->__release();
+          }
+        }
+
+        static constexpr __task_vtable __vtable{&__ready_, &__submit_, &__complete_};
+
+        __t(__context& __context, const __io_request& __request, _Decoder __decoder, _Receiver&& __rcvr)
+          : __task{__vtable}
+          , __context_{__context}
+          , __rcvr_{static_cast<_Receiver&&>(__rcvr)}
+          , __request_{__request}
+          , __decoder_{static_cast<_Decoder&&>(__decoder)}
+          , __cancel_operation_{this} {
+        }
+
+        ~__t() {
+          __free_slots_.append(__returned_slots_.pop_all());
+          while (!__free_slots_.empty()) {
+            delete __free_slots_.pop_front();
+          }
+        }
+
+        // Submits an IORING_OP_ASYNC_CANCEL for the multishot request.
+        struct __cancel_operation : __task {
+          __t* __op_;
+
+          static auto __ready_(__task*) noexcept -> bool {
+            return false;
+          }
+
+          static void __submit_(__task* __pointer, ::io_uring_sqe& __sqe) noexcept {
+            auto* __self = static_cast<__cancel_operation*>(__pointer);
+            __sqe = ::io_uring_sqe{};
+            __sqe.opcode = IORING_OP_ASYNC_CANCEL;
+            __sqe.fd = -1;
+            __sqe.addr = bit_cast<__u64>(static_cast<__task*>(__self->__op_));
+          }
+
+          static void __complete_(__task* __pointer, const ::io_uring_cqe&) noexcept {
+            static_cast<__cancel_operation*>(__pointer)->__op_->__release();
+          }
+
+          static constexpr __task_vtable __vtable{&__ready_, &__submit_, &__complete_};
+
+          explicit __cancel_operation(__t* __op) noexcept
+            : __task{__vtable}
+            , __op_{__op} {
+          }
+        };
+
+        struct __stop_callback {
+          __t* __self_;
+
+          void operator()() noexcept {
+            __self_->__request_cancel();
+          }
+        };
+
+        using __on_context_stop_t = std::optional<stdexec::inplace_stop_callback<__stop_callback>>;
+        using __on_receiver_stop_t = std::optional<typename stdexec::stop_token_of_t<
+          stdexec::env_of_t<_Receiver>&>::template callback_type<__stop_callback>>;
+
+        __context& __context_;
+        _Receiver __rcvr_;
+        __io_request __request_;
+        STDEXEC_ATTRIBUTE((no_unique_address))
+        _Decoder __decoder_;
+        // One count for the multishot request, one for the cancel request and one for each
+        // item that has not yet completed.
+        std::atomic<int> __n_pending_{1};
+        std::atomic<bool> __cancel_requested_{false};
+        std::atomic<bool> __has_error_{false};
+        std::exception_ptr __error_{};
+        __cancel_operation __cancel_operation_;
+        __on_context_stop_t __on_context_stop_{};
+        __on_receiver_stop_t __on_receiver_stop_{};
+        // Slots of completed items. Items may complete on any thread.
+        __atomic_intrusive_queue<&__item_slot::__next_> __returned_slots_{};
+        // Only accessed on the context's thread.
+        stdexec::__intrusive_queue<&__item_slot::__next_> __free_slots_{};
+
+        void __request_cancel() noexcept {
+          if (!__cancel_requested_.exchange(true, std::memory_order_relaxed)) {
+            __n_pending_.fetch_add(1, std::memory_order_relaxed);
+            if (__context_.submit(&__cancel_operation_)) {
+              __context_.wakeup();
+            }
+          }
+        }
+
+        auto __take_slot() -> __item_slot* {
+          if (__free_slots_.empty()) {
+            __free_slots_.append(__returned_slots_.pop_all());
+          }
+          if (!__free_slots_.empty()) {
+            return __free_slots_.pop_front();
+          }
+          return new __item_slot{};
+        }
+
+        void __set_error(std::exception_ptr __error) noexcept {
+          if (!__has_error_.exchange(true, std::memory_order_relaxed)) {
+            __error_ = static_cast<std::exception_ptr&&>(__error);
+          }
+          __request_cancel();
+        }
+
+        void __start_item(_Value __value) noexcept {
+          __n_pending_.fetch_add(1, std::memory_order_relaxed);
+          __item_slot* __slot = nullptr;
+          try {
+            __slot = __take_slot();
+            auto* __item = ::new (static_cast<void*>(__slot->__storage_))
+              __item_operation{this, __slot, static_cast<_Value&&>(__value)};
+            stdexec::start(__item->__op_);
+          } catch (...) {
+            if (__slot) {
+              __free_slots_.push_back(__slot);
+            }
+            __set_error(std::current_exception());
+            __release();
+          }
+        }
+
+        void __item_completed(__item_slot* __slot, bool __stopped) noexcept {
+          std::destroy_at(__slot->__item());
+          __returned_slots_.push_front(__slot);
+          if (__stopped) {
+            __request_cancel();
+          }
+          __release();
+        }
+
+        void __release() noexcept {
+          if (__n_pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (__has_error_.load(std::memory_order_relaxed)) {
+              stdexec::set_error(
+                static_cast<_Receiver&&>(__rcvr_), static_cast<std::exception_ptr&&>(__error_));
+            } else if (__context_.stop_requested()) {
+              stdexec::set_stopped(static_cast<_Receiver&&>(__rcvr_));
+            } else {
+              exec::__set_value_unless_stopped(static_cast<_Receiver&&>(__rcvr_));
+            }
+          }
+        }
+
+        friend void tag_invoke(stdexec::start_t, __t& __self) noexcept {
+          if (__self.__context_.submit(&__self)) {
+            __self.__context_.wakeup();
+          }
+        }
+      };
+    };
+#    endif
+
+    class __scheduler {
+     public:
+      __context* __context_;
+
+      friend auto operator==(const __scheduler& __lhs, const __scheduler& __rhs) -> bool = default;
+
+      class __schedule_env {
+       public:
+        __context* __context_;
+       private:
+        friend auto tag_invoke(
+          stdexec::get_completion_scheduler_t<stdexec::set_value_t>,
+          const __schedule_env& __env) noexcept -> __scheduler {
+          return __scheduler{__env.__context_};
+        }
+      };
+
+      class __schedule_sender {
+        __schedule_env __env_;
+       public:
+        using sender_concept = stdexec::sender_t;
+        using __id = __schedule_sender;
+        using __t = __schedule_sender;
+
+        explicit __schedule_sender(__schedule_env __env) noexcept
+          : __env_{__env} {
+        }
+
+       private:
+        friend auto tag_invoke(stdexec::get_env_t, const __schedule_sender& __sender) noexcept
+          -> __schedule_env {
+          return __sender.__env_;
+        }
+
+        using __completion_sigs =
+          stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_stopped_t()>;
+
+        template <class _Env>
+        friend auto
+          tag_invoke(stdexec::get_completion_signatures_t, const __schedule_sender&, _Env) noexcept
+          -> __completion_sigs {
+          return {};
+        }
+
+        template <typename _Receiver, std::enable_if_t<stdexec::receiver_of<_Receiver, __completion_sigs>, int> = 0>
+        friend auto
+          tag_invoke(stdexec::connect_t, const __schedule_sender& __sender, _Receiver&& __receiver)
+            -> stdexec::__t<__schedule_operation<stdexec::__id<_Receiver>>> {
+          return stdexec::__t<__schedule_operation<stdexec::__id<_Receiver>>>(
+            std::in_place, *__sender.__env_.__context_, static_cast<_Receiver&&>(__receiver));
+        }
+      };
+
+      class __schedule_after_sender {
+       public:
+        using sender_concept = stdexec::sender_t;
+        using __id = __schedule_after_sender;
+        using __t = __schedule_after_sender;
+
+        __schedule_env __env_;
+        std::chrono::nanoseconds __duration_;
+
+       private:
+        friend auto tag_invoke(stdexec::get_env_t, const __schedule_after_sender& __sender) noexcept
+          -> __schedule_env {
+          return __sender.__env_;
+        }
+
+        using __completion_sigs = stdexec::completion_signatures<
+          stdexec::set_value_t(),
+          stdexec::set_error_t(std::exception_ptr),
+          stdexec::set_stopped_t()>;
+
+        template <class _Env>
+        friend auto tag_invoke(
+          stdexec::get_completion_signatures_t,
+          const __schedule_after_sender&,
+          _Env) noexcept -> __completion_sigs {
+          return {};
+        }
+
+        template <typename _Receiver, std::enable_if_t<stdexec::receiver_of<_Receiver, __completion_sigs>, int> = 0>
+        friend auto tag_invoke(
+          stdexec::connect_t,
+          const __schedule_after_sender& __sender,
+          _Receiver&& __receiver)
+          -> stdexec::__t<__timer_operation<stdexec::__id<_Receiver>>> {
+          return stdexec::__t<__timer_operation<stdexec::__id<_Receiver>>>(
+            *__sender.__env_.__context_,
+            __sender.__duration_,
+            static_cast<_Receiver&&>(__receiver));
+        }
+      };
+
+     private:
+      friend auto tag_invoke(stdexec::schedule_t, const __scheduler& __sched) -> __schedule_sender {
+        return __schedule_sender{__schedule_env{__sched.__context_}};
+      }
+
+      friend auto tag_invoke(exec::now_t, const __scheduler& __sched) noexcept
+        -> std::chrono::time_point<std::chrono::steady_clock> {
+        return std::chrono::steady_clock::now();
+      }
+
+      friend auto tag_invoke(
         exec::schedule_after_t,
         const __scheduler& __sched,
         std::chrono::nanoseconds __duration) -> __schedule_after_sender {
@@ -1169,12 +2151,800 @@ namespace exec {
       }
     };
 
+    template <class _Value>
+    struct __set_value_sig {
+      using __t = stdexec::set_value_t(_Value);
+    };
+
+    template <>
+    struct __set_value_sig<void> {
+      using __t = stdexec::set_value_t();
+    };
+
+    // A sender that performs a single io request and completes with its result.
+    template <class _Value>
+    class __io_sender {
+     public:
+      using sender_concept = stdexec::sender_t;
+      using __id = __io_sender;
+      using __t = __io_sender;
+
+      explicit __io_sender(__scheduler::__schedule_env __env, const __io_request& __request) noexcept
+        : __env_{__env}
+        , __request_{__request} {
+      }
+
+     private:
+      template <bool, class...>
+      friend class __linked_sender;
+
+      __scheduler::__schedule_env __env_;
+      __io_request __request_;
+
+      friend auto tag_invoke(stdexec::get_env_t, const __io_sender& __sender) noexcept
+        -> __scheduler::__schedule_env {
+        return __sender.__env_;
+      }
+
+      using __completion_sigs = stdexec::completion_signatures<
+        stdexec::__t<__set_value_sig<_Value>>,
+        stdexec::set_error_t(std::exception_ptr),
+        stdexec::set_stopped_t()>;
+
+      template <class _Env>
+      friend auto
+        tag_invoke(stdexec::get_completion_signatures_t, const __io_sender&, _Env) noexcept
+        -> __completion_sigs {
+        return {};
+      }
+
+      template <typename _Receiver, std::enable_if_t<stdexec::receiver_of<_Receiver, __completion_sigs>, int> = 0>
+      friend auto
+        tag_invoke(stdexec::connect_t, const __io_sender& __sender, _Receiver&& __receiver)
+          -> stdexec::__t<__io_operation<stdexec::__id<_Receiver>, _Value>> {
+        return stdexec::__t<__io_operation<stdexec::__id<_Receiver>, _Value>>(
+          std::in_place,
+          *__sender.__env_.__context_,
+          __sender.__request_,
+          static_cast<_Receiver&&>(__receiver));
+      }
+    };
+
+    template <class _Byte>
+    inline auto __make_single_buffer_request(
+      __u8 __opcode,
+      int __fd,
+      std::span<_Byte> __buffer,
+      ::off_t __offset,
+      __u16 __buf_index = 0) noexcept -> __io_request {
+      __io_request __request{
+        .__opcode_ = __opcode,
+        .__fd_ = __fd,
+        .__offset_ = static_cast<__u64>(__offset),
+        .__addr_ = bit_cast<__u64>(__buffer.data()),
+        .__len_ = static_cast<__u32>(
+          std::min<std::size_t>(__buffer.size(), std::numeric_limits<__u32>::max())),
+        .__buf_index_ = __buf_index};
+#    ifndef STDEXEC_HAS_IORING_OP_READ
+      __request.__single_buffer_ = __opcode == __read_opcode || __opcode == __write_opcode;
+#    endif
+      return __request;
+    }
+
+    inline auto __make_vectored_request(
+      __u8 __opcode,
+      int __fd,
+      std::span<const ::iovec> __buffers,
+      ::off_t __offset) noexcept -> __io_request {
+      return __io_request{
+        .__opcode_ = __opcode,
+        .__fd_ = __fd,
+        .__offset_ = static_cast<__u64>(__offset),
+        .__addr_ = bit_cast<__u64>(__buffers.data()),
+        .__len_ = static_cast<__u32>(__buffers.size())};
+    }
+
+    /// @brief Reads up to `__buffer.size()` bytes from `__fd` at `__offset`.
+    ///
+    /// An offset of -1 reads from the current file position.
+    /// The returned sender completes with the number of bytes read.
+    inline auto async_read_some(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<std::byte> __buffer,
+      ::off_t __offset = -1) noexcept -> __io_sender<std::size_t> {
+      return __io_sender<std::size_t>{
+        {__sched.__context_},
+        __make_single_buffer_request(__read_opcode, __fd, __buffer, __offset)};
+    }
+
+    /// @brief Writes up to `__buffer.size()` bytes to `__fd` at `__offset`.
+    ///
+    /// An offset of -1 writes to the current file position.
+    /// The returned sender completes with the number of bytes written.
+    inline auto async_write_some(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<const std::byte> __buffer,
+      ::off_t __offset = -1) noexcept -> __io_sender<std::size_t> {
+      return __io_sender<std::size_t>{
+        {__sched.__context_},
+        __make_single_buffer_request(__write_opcode, __fd, __buffer, __offset)};
+    }
+
+    /// @brief Scatter read into `__buffers`. The iovec array must outlive the operation.
+    inline auto async_readv(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<const ::iovec> __buffers,
+      ::off_t __offset = -1) noexcept -> __io_sender<std::size_t> {
+      return __io_sender<std::size_t>{
+        {__sched.__context_},
+        __make_vectored_request(IORING_OP_READV, __fd, __buffers, __offset)};
+    }
+
+    /// @brief Gather write from `__buffers`. The iovec array must outlive the operation.
+    inline auto async_writev(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<const ::iovec> __buffers,
+      ::off_t __offset = -1) noexcept -> __io_sender<std::size_t> {
+      return __io_sender<std::size_t>{
+        {__sched.__context_},
+        __make_vectored_request(IORING_OP_WRITEV, __fd, __buffers, __offset)};
+    }
+
+    /// @brief Reads into a subrange of the registered buffer with index `__buf_index`.
+    ///
+    /// `__buffer` must lie within the buffer registered with
+    /// io_uring_context::register_buffers() at that index.
+    inline auto async_read_some_fixed(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<std::byte> __buffer,
+      unsigned __buf_index,
+      ::off_t __offset = -1) noexcept -> __io_sender<std::size_t> {
+      return __io_sender<std::size_t>{
+        {__sched.__context_},
+        __make_single_buffer_request(
+          IORING_OP_READ_FIXED, __fd, __buffer, __offset, static_cast<__u16>(__buf_index))};
+    }
+
+    /// @brief Writes from a subrange of the registered buffer with index `__buf_index`.
+    inline auto async_write_some_fixed(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<const std::byte> __buffer,
+      unsigned __buf_index,
+      ::off_t __offset = -1) noexcept -> __io_sender<std::size_t> {
+      return __io_sender<std::size_t>{
+        {__sched.__context_},
+        __make_single_buffer_request(
+          IORING_OP_WRITE_FIXED, __fd, __buffer, __offset, static_cast<__u16>(__buf_index))};
+    }
+
+    /// @brief Flushes `__fd` to disk. Pass IORING_FSYNC_DATASYNC to skip the metadata.
+    inline auto async_fsync(const __scheduler& __sched, int __fd, unsigned __flags = 0) noexcept
+      -> __io_sender<void> {
+      return __io_sender<void>{
+        {__sched.__context_},
+        __io_request{.__opcode_ = IORING_OP_FSYNC, .__fd_ = __fd, .__op_flags_ = __flags}};
+    }
+
+#    ifdef STDEXEC_HAS_IORING_OP_READ
+    /// @brief Closes `__fd`.
+    inline auto async_close(const __scheduler& __sched, int __fd) noexcept -> __io_sender<void> {
+      return __io_sender<void>{
+        {__sched.__context_}, __io_request{.__opcode_ = IORING_OP_CLOSE, .__fd_ = __fd}};
+    }
+#    endif
+
+#    ifdef STDEXEC_HAS_IO_URING_SOCKETS
+    /// @brief Accepts a connection on the listening socket `__fd`.
+    ///
+    /// The returned sender completes with the file descriptor of the accepted socket.
+    inline auto async_accept(
+      const __scheduler& __sched,
+      int __fd,
+      ::sockaddr* __addr = nullptr,
+      ::socklen_t* __addrlen = nullptr,
+      int __flags = SOCK_CLOEXEC) noexcept -> __io_sender<int> {
+      return __io_sender<int>{
+        {__sched.__context_},
+        __io_request{
+          .__opcode_ = IORING_OP_ACCEPT,
+          .__fd_ = __fd,
+          .__offset_ = bit_cast<__u64>(__addrlen),
+          .__addr_ = bit_cast<__u64>(__addr),
+          .__op_flags_ = static_cast<__u32>(__flags)}};
+    }
+
+    /// @brief Connects the socket `__fd` to `__addr`.
+    inline auto async_connect(
+      const __scheduler& __sched,
+      int __fd,
+      const ::sockaddr* __addr,
+      ::socklen_t __addrlen) noexcept -> __io_sender<void> {
+      return __io_sender<void>{
+        {__sched.__context_},
+        __io_request{
+          .__opcode_ = IORING_OP_CONNECT,
+          .__fd_ = __fd,
+          .__offset_ = __addrlen,
+          .__addr_ = bit_cast<__u64>(__addr)}};
+    }
+
+    /// @brief Sends up to `__buffer.size()` bytes on the socket `__fd`.
+    inline auto async_send(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<const std::byte> __buffer,
+      int __flags = 0) noexcept -> __io_sender<std::size_t> {
+      __io_request __request = __make_single_buffer_request(IORING_OP_SEND, __fd, __buffer, 0);
+      __request.__op_flags_ = static_cast<__u32>(__flags);
+      return __io_sender<std::size_t>{{__sched.__context_}, __request};
+    }
+
+    /// @brief Receives up to `__buffer.size()` bytes from the socket `__fd`.
+    ///
+    /// The returned sender completes with 0 if the peer has performed an orderly shutdown.
+    inline auto async_recv(
+      const __scheduler& __sched,
+      int __fd,
+      std::span<std::byte> __buffer,
+      int __flags = 0) noexcept -> __io_sender<std::size_t> {
+      __io_request __request = __make_single_buffer_request(IORING_OP_RECV, __fd, __buffer, 0);
+      __request.__op_flags_ = static_cast<__u32>(__flags);
+      return __io_sender<std::size_t>{{__sched.__context_}, __request};
+    }
+#    endif
+
+#    ifdef STDEXEC_HAS_IO_URING_ASYNC_CANCELLATION
+    template <class _Value>
+    inline auto __linked_value(int __res) noexcept {
+      if constexpr (std::is_void_v<_Value>) {
+        return std::tuple<>{};
+      } else {
+        return std::tuple<_Value>{static_cast<_Value>(__res)};
+      }
+    }
+
+    template <class _Tuple>
+    struct __set_value_from_tuple;
+
+    template <class... _Ts>
+    struct __set_value_from_tuple<std::tuple<_Ts...>> {
+      using __t = stdexec::set_value_t(_Ts...);
+    };
+
+    // The values of a linked chain, with void results left out.
+    template <class... _Values>
+    using __linked_set_value_t = stdexec::__t<
+      __set_value_from_tuple<decltype(std::tuple_cat(__linked_value<_Values>(0)...))>>;
+
+    // Submits all requests as one chain of submission queue entries with IOSQE_IO_LINK (or
+    // IOSQE_IO_HARDLINK) set on every entry but the last. The kernel starts a request once its
+    // predecessor has completed and posts the completions in chain order, so the n-th cqe for
+    // this task belongs to the n-th request.
+    template <class _ReceiverId, bool _HardLink, class... _Values>
+    struct __linked_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      static constexpr std::size_t __n_requests = sizeof...(_Values);
+
+      class __t : public __task {
+       public:
+        static auto __ready_(__task*) noexcept -> bool {
+          return false;
+        }
+
+        static void __submit_(__task* __pointer, ::io_uring_sqe& __sqe) noexcept {
+          auto* __self = static_cast<__t*>(__pointer);
+          const std::size_t __i = __self->__n_submitted_++;
+          if (__i == 0) {
+            __self->__on_context_stop_.emplace(
+              __self->__context_.get_stop_token(), __stop_callback{__self});
+            __self->__on_receiver_stop_.emplace(
+              stdexec::get_stop_token(stdexec::get_env(__self->__rcvr_)), __stop_callback{__self});
+          }
+          __sqe = __make_sqe(__self->__requests_[__i]);
+#      ifndef STDEXEC_HAS_IORING_OP_READ
+          if (__self->__requests_[__i].__single_buffer_) {
+            __sqe.addr = bit_cast<__u64>(&__self->__iovs_[__i]);
+            __sqe.len = 1;
+          }
+#      endif
+          if (__i + 1 < __n_requests) {
+            __sqe.flags |= _HardLink ? IOSQE_IO_HARDLINK : IOSQE_IO_LINK;
+          }
+        }
+
+        static void __complete_(__task* __pointer, const ::io_uring_cqe& __cqe) noexcept {
+          auto* __self = static_cast<__t*>(__pointer);
+          if (__self->__n_submitted_ == 0) {
+            // The context was stopped before the chain could be submitted.
+            stdexec::set_stopped(static_cast<_Receiver&&>(__self->__rcvr_));
+            return;
+          }
+          __self->__results_[__self->__n_completed_++] = __cqe.res;
+          if (__self->__n_completed_ == __n_requests) {
+            __self->__on_context_stop_.reset();
+            __self->__on_receiver_stop_.reset();
+            __self->__release();
+          }
+        }
+
+        static constexpr __task_vtable __vtable{
+          &__ready_,
+          &__submit_,
+          &__complete_,
+          static_cast<__u32>(__n_requests)};
+
+        __t(
+          __context& __context,
+          const std::array<__io_request, __n_requests>& __requests,
+          _Receiver&& __rcvr)
+          : __task{__vtable}
+          , __context_{__context}
+          , __rcvr_{static_cast<_Receiver&&>(__rcvr)}
+          , __requests_{__requests}
+          , __cancel_operation_{this} {
+#      ifndef STDEXEC_HAS_IORING_OP_READ
+          for (std::size_t __i = 0; __i < __n_requests; ++__i) {
+            __iovs_[__i] = ::iovec{bit_cast<void*>(__requests[__i].__addr_), __requests[__i].__len_};
+          }
+#      endif
+        }
+
+       private:
+        // Cancels the request of the chain that is currently in flight. The kernel then fails
+        // the remaining requests with -ECANCELED.
+        struct __cancel_operation : __task {
+          __t* __op_;
+
+          static auto __ready_(__task*) noexcept -> bool {
+            return false;
+          }
+
+          static void __submit_(__task* __pointer, ::io_uring_sqe& __sqe) noexcept {
+            auto* __self = static_cast<__cancel_operation*>(__pointer);
+            __sqe = ::io_uring_sqe{};
+            __sqe.opcode = IORING_OP_ASYNC_CANCEL;
+            __sqe.fd = -1;
+            __sqe.addr = bit_cast<__u64>(static_cast<__task*>(__self->__op_));
+          }
+
+          static void __complete_(__task* __pointer, const ::io_uring_cqe&) noexcept {
+            static_cast<__cancel_operation*>(__pointer)->__op_->__release();
+          }
+
+          static constexpr __task_vtable __vtable{&__ready_, &__submit_, &__complete_};
+
+          explicit __cancel_operation(__t* __op) noexcept
+            : __task{__vtable}
+            , __op_{__op} {
+          }
+        };
+
+        struct __stop_callback {
+          __t* __self_;
+
+          void operator()() noexcept {
+            __self_->__request_cancel();
+          }
+        };
+
+        using __on_context_stop_t = std::optional<stdexec::inplace_stop_callback<__stop_callback>>;
+        using __on_receiver_stop_t = std::optional<typename stdexec::stop_token_of_t<
+          stdexec::env_of_t<_Receiver>&>::template callback_type<__stop_callback>>;
+
+        __context& __context_;
+        _Receiver __rcvr_;
+        std::array<__io_request, __n_requests> __requests_;
+#      ifndef STDEXEC_HAS_IORING_OP_READ
+        std::array<::iovec, __n_requests> __iovs_{};
+#      endif
+        std::array<int, __n_requests> __results_{};
+        // Only accessed on the context's thread.
+        std::size_t __n_submitted_{0};
+        std::size_t __n_completed_{0};
+        // One count for the chain and one for the cancel request.
+        std::atomic<int> __n_pending_{1};
+        std::atomic<bool> __cancel_requested_{false};
+        __cancel_operation __cancel_operation_;
+        __on_context_stop_t __on_context_stop_{};
+        __on_receiver_stop_t __on_receiver_stop_{};
+
+        void __request_cancel() noexcept {
+          if (!__cancel_requested_.exchange(true, std::memory_order_relaxed)) {
+            __n_pending_.fetch_add(1, std::memory_order_relaxed);
+            if (__context_.submit(&__cancel_operation_)) {
+              __context_.wakeup();
+            }
+          }
+        }
+
+        void __release() noexcept {
+          if (__n_pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+          }
+          if (
+            __context_.stop_requested()
+            || stdexec::get_stop_token(stdexec::get_env(__rcvr_)).stop_requested()) {
+            stdexec::set_stopped(static_cast<_Receiver&&>(__rcvr_));
+            return;
+          }
+          for (int __res: __results_) {
+            if (__res < 0) {
+              stdexec::set_error(
+                static_cast<_Receiver&&>(__rcvr_),
+                std::make_exception_ptr(std::system_error(-__res, std::system_category())));
+              return;
+            }
+          }
+          [this]<std::size_t... _Is>(std::index_sequence<_Is...>) {
+            std::apply(
+              [this](auto&&... __values) {
+                stdexec::set_value(
+                  static_cast<_Receiver&&>(__rcvr_), static_cast<decltype(__values)&&>(__values)...);
+              },
+              std::tuple_cat(__linked_value<_Values>(__results_[_Is])...));
+          }(std::index_sequence_for<_Values...>{});
+        }
+
+        friend void tag_invoke(stdexec::start_t, __t& __self) noexcept {
+          // A chain that does not fit into the rings would never be submitted and would block
+          // every task queued behind it.
+          if (__n_requests > __self.__context_.max_in_flight()) {
+            stdexec::set_error(
+              static_cast<_Receiver&&>(__self.__rcvr_),
+              std::make_exception_ptr(std::system_error(EINVAL, std::system_category())));
+            return;
+          }
+          if (__self.__context_.submit(&__self)) {
+            __self.__context_.wakeup();
+          }
+        }
+      };
+    };
+
+    // A sender that submits the requests of several io senders as one linked chain.
+    template <bool _HardLink, class... _Values>
+    class __linked_sender {
+     public:
+      using sender_concept = stdexec::sender_t;
+      using __id = __linked_sender;
+      using __t = __linked_sender;
+
+      explicit __linked_sender(const __io_sender<_Values>&... __senders) noexcept
+        : __env_{__first_env(__senders...)}
+        , __requests_{__senders.__request_...} {
+        STDEXEC_ASSERT(((__senders.__env_.__context_ == __env_.__context_) && ...));
+      }
+
+     private:
+      __scheduler::__schedule_env __env_;
+      std::array<__io_request, sizeof...(_Values)> __requests_;
+
+      template <class _First, class... _Rest>
+      static auto __first_env(const _First& __first, const _Rest&...) noexcept
+        -> __scheduler::__schedule_env {
+        return __first.__env_;
+      }
+
+      friend auto tag_invoke(stdexec::get_env_t, const __linked_sender& __sender) noexcept
+        -> __scheduler::__schedule_env {
+        return __sender.__env_;
+      }
+
+      using __completion_sigs = stdexec::completion_signatures<
+        __linked_set_value_t<_Values...>,
+        stdexec::set_error_t(std::exception_ptr),
+        stdexec::set_stopped_t()>;
+
+      template <class _Env>
+      friend auto
+        tag_invoke(stdexec::get_completion_signatures_t, const __linked_sender&, _Env) noexcept
+        -> __completion_sigs {
+        return {};
+      }
+
+      template <class _Receiver>
+      using __operation_t =
+        stdexec::__t<__linked_operation<stdexec::__id<_Receiver>, _HardLink, _Values...>>;
+
+      template <typename _Receiver, std::enable_if_t<stdexec::receiver_of<_Receiver, __completion_sigs>, int> = 0>
+      friend auto
+        tag_invoke(stdexec::connect_t, const __linked_sender& __sender, _Receiver&& __receiver)
+          -> __operation_t<_Receiver> {
+        return __operation_t<_Receiver>(
+          *__sender.__env_.__context_, __sender.__requests_, static_cast<_Receiver&&>(__receiver));
+      }
+    };
+
+    /// @brief Submits the requests of `__senders` as one chain in a single submission.
+    ///
+    /// Each request starts once its predecessor has completed successfully. A failed request,
+    /// or a read or write that transfers fewer bytes than requested, cancels the rest of the
+    /// chain. The returned sender completes with the values of all senders in order, leaving
+    /// out those that complete with no value, or with the first error. A request that was
+    /// cancelled by a broken chain reports ECANCELED.
+    /// All senders must belong to the same context. A chain longer than the context's
+    /// max_in_flight() completes with EINVAL without submitting any request.
+    template <class... _Values>
+      requires(sizeof...(_Values) > 0)
+    inline auto async_linked(const __io_sender<_Values>&... __senders) noexcept
+      -> __linked_sender<false, _Values...> {
+      return __linked_sender<false, _Values...>{__senders...};
+    }
+
+    /// @brief Like async_linked(), but the chain is not broken by failed requests.
+    ///
+    /// All requests run in order regardless of their results. The returned sender completes
+    /// with the first error, if any.
+    template <class... _Values>
+      requires(sizeof...(_Values) > 0)
+    inline auto async_hard_linked(const __io_sender<_Values>&... __senders) noexcept
+      -> __linked_sender<true, _Values...> {
+      return __linked_sender<true, _Values...>{__senders...};
+    }
+#    endif
+
+#    ifdef STDEXEC_HAS_IO_URING_MULTISHOT
+    // A buffer the kernel has picked from a provided buffer ring.
+    class __provided_buffer {
+     public:
+      __provided_buffer(std::span<std::byte> __data, __u16 __id) noexcept
+        : __data_{__data}
+        , __id_{__id} {
+      }
+
+      [[nodiscard]]
+      auto data() const noexcept -> std::span<std::byte> {
+        return __data_;
+      }
+
+      [[nodiscard]]
+      auto id() const noexcept -> __u16 {
+        return __id_;
+      }
+
+     private:
+      std::span<std::byte> __data_;
+      __u16 __id_;
+    };
+
+    /// @brief A ring of equally sized buffers that the kernel selects from for multishot receives.
+    ///
+    /// Every received buffer is owned by the consumer until it is handed back with recycle().
+    /// recycle() is not thread-safe; calls must be serialized by the user.
+    class __buffer_ring : stdexec::__immovable {
+     public:
+      __buffer_ring(
+        __context& __context,
+        __u16 __group_id,
+        __u16 __n_buffers,
+        std::size_t __buffer_size)
+        : __context_{__context}
+        , __group_id_{__group_id}
+        , __mask_{static_cast<__u16>(__n_buffers - 1)}
+        , __buffer_size_{__buffer_size} {
+        STDEXEC_ASSERT(__n_buffers > 0 && (__n_buffers & __mask_) == 0);
+        void* __ring = ::mmap(
+          nullptr,
+          __n_buffers * sizeof(::io_uring_buf),
+          PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS,
+          -1,
+          0);
+        __throw_error_code_if(__ring == MAP_FAILED, errno);
+        __ring_region_ = memory_mapped_region{__ring, __n_buffers * sizeof(::io_uring_buf)};
+        __storage_ = std::make_unique<std::byte[]>(__n_buffers * __buffer_size);
+        __context_.register_buffer_ring(__ring, __n_buffers, __group_id_);
+        for (__u16 __id = 0; __id <= __mask_; ++__id) {
+          __add(__id);
+        }
+        __publish();
+      }
+
+      ~__buffer_ring() {
+        try {
+          __context_.unregister_buffer_ring(__group_id_);
+        } catch (...) {
+        }
+      }
+
+      [[nodiscard]]
+      auto group_id() const noexcept -> __u16 {
+        return __group_id_;
+      }
+
+      [[nodiscard]]
+      auto buffer(__u16 __id) const noexcept -> std::span<std::byte> {
+        return {__storage_.get() + __id * __buffer_size_, __buffer_size_};
+      }
+
+      /// @brief Hands a buffer back to the kernel.
+      void recycle(__u16 __id) noexcept {
+        __add(__id);
+        __publish();
+      }
+
+      void recycle(const __provided_buffer& __buffer) noexcept {
+        recycle(__buffer.id());
+      }
+
+     private:
+      __context& __context_;
+      memory_mapped_region __ring_region_{};
+      std::unique_ptr<std::byte[]> __storage_{};
+      __u16 __group_id_;
+      __u16 __mask_;
+      __u16 __tail_{0};
+      std::size_t __buffer_size_;
+
+      void __add(__u16 __id) noexcept {
+        auto* __bufs = static_cast<::io_uring_buf*>(__ring_region_.data());
+        ::io_uring_buf& __buf = __bufs[__tail_ & __mask_];
+        __buf.addr = bit_cast<__u64>(__storage_.get() + __id * __buffer_size_);
+        __buf.len = static_cast<__u32>(__buffer_size_);
+        __buf.bid = __id;
+        ++__tail_;
+      }
+
+      void __publish() noexcept {
+        auto* __ring = static_cast<::io_uring_buf_ring*>(__ring_region_.data());
+        __atomic_ref<__u16>{__ring->tail}.store(__tail_, std::memory_order_release);
+      }
+    };
+
+    struct __accept_decoder {
+      static auto __has_value(const ::io_uring_cqe& __cqe) noexcept -> bool {
+        return __cqe.res >= 0;
+      }
+
+      auto operator()(const ::io_uring_cqe& __cqe) const noexcept -> int {
+        return __cqe.res;
+      }
+    };
+
+    struct __recv_decoder {
+      const __buffer_ring* __ring_;
+
+      static auto __has_value(const ::io_uring_cqe& __cqe) noexcept -> bool {
+        return __cqe.res > 0 && (__cqe.flags & IORING_CQE_F_BUFFER);
+      }
+
+      auto operator()(const ::io_uring_cqe& __cqe) const noexcept -> __provided_buffer {
+        auto __id = static_cast<__u16>(__cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        return __provided_buffer{
+          __ring_->buffer(__id).first(static_cast<std::size_t>(__cqe.res)), __id};
+      }
+    };
+
+    // A sequence sender that arms a single multishot request.
+    template <class _Decoder>
+    class __multishot_sender {
+      template <class _Receiver>
+      using __operation_t = stdexec::__t<__multishot_operation<stdexec::__id<_Receiver>, _Decoder>>;
+
+      using __value_t =
+        decltype(std::declval<const _Decoder&>()(std::declval<const ::io_uring_cqe&>()));
+
+     public:
+      using sender_concept = exec::sequence_sender_t;
+      using __id = __multishot_sender;
+      using __t = __multishot_sender;
+      using completion_signatures = stdexec::completion_signatures<
+        stdexec::set_value_t(),
+        stdexec::set_error_t(std::exception_ptr),
+        stdexec::set_stopped_t()>;
+      using item_types = exec::item_types<decltype(stdexec::just(std::declval<__value_t>()))>;
+
+      __multishot_sender(
+        __scheduler::__schedule_env __env,
+        const __io_request& __request,
+        _Decoder __decoder) noexcept
+        : __env_{__env}
+        , __request_{__request}
+        , __decoder_{__decoder} {
+      }
+
+     private:
+      __scheduler::__schedule_env __env_;
+      __io_request __request_;
+      _Decoder __decoder_;
+
+      friend auto tag_invoke(stdexec::get_env_t, const __multishot_sender& __sender) noexcept
+        -> __scheduler::__schedule_env {
+        return __sender.__env_;
+      }
+
+      template <exec::sequence_receiver_of<item_types> _Receiver>
+      friend auto
+        tag_invoke(exec::subscribe_t, const __multishot_sender& __sender, _Receiver __rcvr)
+          -> __operation_t<_Receiver> {
+        return __operation_t<_Receiver>{
+          *__sender.__env_.__context_,
+          __sender.__request_,
+          __sender.__decoder_,
+          static_cast<_Receiver&&>(__rcvr)};
+      }
+    };
+
+    /// @brief Accepts connections on `__fd` with a single multishot request.
+    ///
+    /// The returned sequence sender produces one item per accepted socket.
+    inline auto async_accept_multishot(
+      const __scheduler& __sched,
+      int __fd,
+      int __flags = SOCK_CLOEXEC) noexcept -> __multishot_sender<__accept_decoder> {
+      return __multishot_sender<__accept_decoder>{
+        {__sched.__context_},
+        __io_request{
+          .__opcode_ = IORING_OP_ACCEPT,
+          .__ioprio_ = IORING_ACCEPT_MULTISHOT,
+          .__fd_ = __fd,
+          .__op_flags_ = static_cast<__u32>(__flags)},
+        __accept_decoder{}};
+    }
+
+    /// @brief Receives from `__fd` into buffers picked from `__ring` with a single multishot request.
+    ///
+    /// The returned sequence sender produces one __provided_buffer per received chunk and completes
+    /// when the peer shuts down the connection. Each buffer has to be recycled into `__ring`.
+    /// If the ring runs out of buffers, the kernel ends the request and the sequence completes
+    /// with a std::system_error of ENOBUFS. Keep enough buffers in the ring, or start a new
+    /// receive after that error.
+    inline auto async_recv_multishot(
+      const __scheduler& __sched,
+      int __fd,
+      const __buffer_ring& __ring,
+      int __flags = 0) noexcept -> __multishot_sender<__recv_decoder> {
+      return __multishot_sender<__recv_decoder>{
+        {__sched.__context_},
+        __io_request{
+          .__opcode_ = IORING_OP_RECV,
+          .__sqe_flags_ = IOSQE_BUFFER_SELECT,
+          .__ioprio_ = IORING_RECV_MULTISHOT,
+          .__fd_ = __fd,
+          .__op_flags_ = static_cast<__u32>(__flags),
+          .__buf_index_ = __ring.group_id()},
+        __recv_decoder{&__ring}};
+    }
+#    endif
+
     inline auto __context::get_scheduler() noexcept -> __scheduler {
       return __scheduler{this};
     }
   } // namespace __io_uring
 
   using __io_uring::until;
+  using __io_uring::async_read_some;
+  using __io_uring::async_write_some;
+  using __io_uring::async_readv;
+  using __io_uring::async_writev;
+  using __io_uring::async_read_some_fixed;
+  using __io_uring::async_write_some_fixed;
+  using __io_uring::async_fsync;
+#    ifdef STDEXEC_HAS_IORING_OP_READ
+  using __io_uring::async_close;
+#    endif
+#    ifdef STDEXEC_HAS_IO_URING_ASYNC_CANCELLATION
+  using __io_uring::async_linked;
+  using __io_uring::async_hard_linked;
+#    endif
+#    ifdef STDEXEC_HAS_IO_URING_SOCKETS
+  using __io_uring::async_accept;
+  using __io_uring::async_connect;
+  using __io_uring::async_send;
+  using __io_uring::async_recv;
+#    endif
+#    ifdef STDEXEC_HAS_IO_URING_MULTISHOT
+  using __io_uring::async_accept_multishot;
+  using __io_uring::async_recv_multishot;
+  using io_uring_buffer_ring = __io_uring::__buffer_ring;
+  using io_uring_provided_buffer = __io_uring::__provided_buffer;
+#    endif
   using io_uring_context = __io_uring::__context;
   using io_uring_scheduler = __io_uring::__scheduler;
 } // namespace exec
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2023 Maikel Nadolski
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "./io_uring_context.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace exec {
+  struct io_uring_pool_params {
+    // The number of rings. Each ring is driven by its own thread.
+    std::size_t n_rings{std::max(1u, std::thread::hardware_concurrency())};
+    // Pins the thread of the i-th ring to the i-th cpu that the process may run on, modulo the
+    // number of these cpus.
+    bool pin_threads{false};
+    // The configuration of every ring.
+    io_uring_context_params ring_params{};
+    // Called on the thread of every ring with the ring and its index, before the ring runs, e.g.
+    // to register buffers. Single issuer rings accept registrations only from this thread. The
+    // constructor waits for all calls and rethrows the first exception.
+    std::function<void(io_uring_context&, std::size_t)> setup{};
+  };
+
+  // Owns several io_uring contexts, each driven by a dedicated thread, behind one scheduler.
+  //
+  // Work that is started from one of the pool's threads goes to that thread's ring. Work that
+  // is started from any other thread is distributed round-robin over all rings.
+  //
+  // If a ring thread fails, the pool stops all rings. join() rethrows the error. The destructor
+  // drops it.
+  class io_uring_pool {
+   public:
+    explicit io_uring_pool(std::size_t __n_rings = std::max(1u, std::thread::hardware_concurrency()))
+      : io_uring_pool(__with_rings(__n_rings)) {
+    }
+
+    explicit io_uring_pool(const io_uring_pool_params& __params) {
+      STDEXEC_ASSERT(__params.n_rings > 0);
+      __rings_.reserve(__params.n_rings);
+      for (std::size_t __i = 0; __i < __params.n_rings; ++__i) {
+        __rings_.push_back(std::make_unique<io_uring_context>(__params.ring_params));
+      }
+      __threads_.reserve(__params.n_rings);
+      std::latch __set_up{static_cast<std::ptrdiff_t>(__params.n_rings)};
+      try {
+        const std::vector<int> __cpus =
+          __params.pin_threads ? __allowed_cpus() : std::vector<int>{};
+        for (std::size_t __i = 0; __i < __params.n_rings; ++__i) {
+          const int __cpu = __cpus.empty() ? -1 : __cpus[__i % __cpus.size()];
+          __threads_.emplace_back(
+            [this, __ring = __rings_[__i].get(), __i, __cpu, &__setup = __params.setup, &__set_up] {
+              __pin_this_thread(__cpu);
+              __this_thread_pool_ = this;
+              __this_thread_ring_ = __ring;
+              try {
+                if (__setup) {
+                  __setup(*__ring, __i);
+                }
+              } catch (...) {
+                __fail(std::current_exception());
+              }
+              // The constructor may return once the count drops to zero.
+              __set_up.count_down();
+              try {
+                __ring->run_until_stopped();
+              } catch (...) {
+                __fail(std::current_exception());
+              }
+            });
+        }
+      } catch (...) {
+        __stop_and_join();
+        throw;
+      }
+      __set_up.wait();
+      std::exception_ptr __error{};
+      {
+        std::lock_guard __lock{__error_mutex_};
+        __error = __error_;
+      }
+      if (__error) {
+        __stop_and_join();
+        std::rethrow_exception(__error);
+      }
+    }
+
+    ~io_uring_pool() {
+      __stop_and_join();
+    }
+
+    io_uring_pool(io_uring_pool&&) = delete;
+
+    class scheduler {
+     public:
+      friend auto operator==(const scheduler&, const scheduler&) -> bool = default;
+
+      /// @brief Returns the scheduler of the ring that new work from this thread goes to.
+      ///
+      /// Use this to pass the pool to the io functions such as async_read_some(). On other
+      /// threads, every conversion picks the next ring. Convert once to keep several
+      /// operations on the same ring, e.g. for async_linked().
+      operator io_uring_scheduler() const noexcept {
+        return __pool_->__select_ring().get_scheduler();
+      }
+
+      struct __env {
+        io_uring_pool* __pool_;
+
+        friend auto tag_invoke(
+          stdexec::get_completion_scheduler_t<stdexec::set_value_t>,
+          const __env& __self) noexcept -> scheduler {
+          return __self.__pool_->get_scheduler();
+        }
+      };
+
+      using __ring_schedule_sender_t =
+        decltype(stdexec::schedule(std::declval<const io_uring_scheduler&>()));
+      using __ring_schedule_after_sender_t = decltype(exec::schedule_after(
+        std::declval<const io_uring_scheduler&>(),
+        std::declval<std::chrono::nanoseconds>()));
+
+      // Picks the ring when it is connected and completes on that ring.
+      template <class _RingSender>
+      class __sender {
+       public:
+        using sender_concept = stdexec::sender_t;
+        using __id = __sender;
+        using __t = __sender;
+
+        template <class _Env>
+        using __completion_sigs = stdexec::completion_signatures_of_t<_RingSender, _Env>;
+
+        __sender(io_uring_pool* __pool, std::chrono::nanoseconds __duration) noexcept
+          : __pool_{__pool}
+          , __duration_{__duration} {
+        }
+
+       private:
+        io_uring_pool* __pool_;
+        std::chrono::nanoseconds __duration_;
+
+        auto __ring_sender() const noexcept -> _RingSender {
+          io_uring_scheduler __ring = __pool_->__select_ring().get_scheduler();
+          if constexpr (std::same_as<_RingSender, __ring_schedule_sender_t>) {
+            return stdexec::schedule(__ring);
+          } else {
+            return exec::schedule_after(__ring, __duration_);
+          }
+        }
+
+        friend auto tag_invoke(stdexec::get_env_t, const __sender& __self) noexcept -> __env {
+          return __env{__self.__pool_};
+        }
+
+        template <class _Env>
+        friend auto tag_invoke(stdexec::get_completion_signatures_t, const __sender&, _Env) noexcept
+          -> __completion_sigs<_Env> {
+          return {};
+        }
+
+        template <typename _Receiver, std::enable_if_t<stdexec::receiver_of<_Receiver, __completion_sigs<stdexec::env_of_t<_Receiver>>>, int> = 0>
+        friend auto tag_invoke(stdexec::connect_t, const __sender& __self, _Receiver&& __rcvr)
+          -> stdexec::connect_result_t<_RingSender, _Receiver> {
+          return stdexec::connect(__self.__ring_sender(), static_cast<_Receiver&&>(__rcvr));
+        }
+      };
+
+     private:
+      friend class io_uring_pool;
+
+      explicit scheduler(io_uring_pool* __pool) noexcept
+        : __pool_{__pool} {
+      }
+
+      io_uring_pool* __pool_;
+
+      friend auto tag_invoke(stdexec::schedule_t, const scheduler& __self) noexcept
+        -> __sender<__ring_schedule_sender_t> {
+        return {__self.__pool_, std::chrono::nanoseconds{0}};
+      }
+
+      friend auto tag_invoke(exec::now_t, const scheduler&) noexcept
+        -> std::chrono::time_point<std::chrono::steady_clock> {
+        return std::chrono::steady_clock::now();
+      }
+
+      friend auto tag_invoke(
+        exec::schedule_after_t,
+        const scheduler& __self,
+        std::chrono::nanoseconds __duration) noexcept -> __sender<__ring_schedule_after_sender_t> {
+        return {__self.__pool_, __duration};
+      }
+
+      template <class _Clock, class _Duration>
+      friend auto tag_invoke(
+        exec::schedule_at_t,
+        const scheduler& __self,
+        const std::chrono::time_point<_Clock, _Duration>& __time_point) noexcept
+        -> __sender<__ring_schedule_after_sender_t> {
+        return {__self.__pool_, __time_point - _Clock::now()};
+      }
+    };
+
+    auto get_scheduler() noexcept -> scheduler {
+      return scheduler{this};
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t {
+      return __rings_.size();
+    }
+
+    /// @brief Returns the ring with index `__index`.
+    ///
+    /// The ring already runs on its own thread. Rings with single_issuer or defer_taskrun set
+    /// reject registrations from other threads, so register their buffers in
+    /// io_uring_pool_params::setup.
+    auto ring(std::size_t __index) noexcept -> io_uring_context& {
+      return *__rings_[__index];
+    }
+
+    void request_stop() {
+      for (auto& __ring: __rings_) {
+        __ring->request_stop();
+      }
+    }
+
+    /// @brief Stops all rings and waits for their threads.
+    ///
+    /// Rethrows the first exception that a ring thread threw, if any.
+    void join() {
+      __stop_and_join();
+      std::exception_ptr __error{};
+      {
+        std::lock_guard __lock{__error_mutex_};
+        __error = std::exchange(__error_, nullptr);
+      }
+      if (__error) {
+        std::rethrow_exception(__error);
+      }
+    }
+
+   private:
+    static thread_local io_uring_pool* __this_thread_pool_;
+    static thread_local io_uring_context* __this_thread_ring_;
+
+    std::vector<std::unique_ptr<io_uring_context>> __rings_;
+    std::vector<std::thread> __threads_;
+    std::atomic<std::size_t> __next_ring_{0};
+    std::mutex __error_mutex_;
+    std::exception_ptr __error_{};
+
+    auto __select_ring() noexcept -> io_uring_context& {
+      if (__this_thread_pool_ == this) {
+        return *__this_thread_ring_;
+      }
+      const std::size_t __n = __next_ring_.fetch_add(1, std::memory_order_relaxed);
+      return *__rings_[__n % __rings_.size()];
+    }
+
+    static auto __with_rings(std::size_t __n_rings) -> io_uring_pool_params {
+      io_uring_pool_params __params{};
+      __params.n_rings = __n_rings;
+      return __params;
+    }
+
+    // Returns the cpus that this process may run on.
+    static auto __allowed_cpus() -> std::vector<int> {
+      std::vector<int> __cpus{};
+      ::cpu_set_t __mask;
+      CPU_ZERO(&__mask);
+      if (::sched_getaffinity(0, sizeof(__mask), &__mask) == 0) {
+        for (int __cpu = 0; __cpu < CPU_SETSIZE; ++__cpu) {
+          if (CPU_ISSET(__cpu, &__mask)) {
+            __cpus.push_back(__cpu);
+          }
+        }
+      }
+      return __cpus;
+    }
+
+    // Pins the calling thread to `__cpu`. If that fails, the thread keeps its affinity.
+    static void __pin_this_thread(int __cpu) noexcept {
+      if (__cpu < 0 || __cpu >= CPU_SETSIZE) {
+        return;
+      }
+      ::cpu_set_t __cpus;
+      CPU_ZERO(&__cpus);
+      CPU_SET(__cpu, &__cpus);
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(__cpus), &__cpus);
+    }
+
+    // Keeps the first error of a ring thread and stops the other rings.
+    void __fail(std::exception_ptr __error) noexcept {
+      {
+        std::lock_guard __lock{__error_mutex_};
+        if (!__error_) {
+          __error_ = static_cast<std::exception_ptr&&>(__error);
+        }
+      }
+      __request_stop_all();
+    }
+
+    void __request_stop_all() noexcept {
+      for (auto& __ring: __rings_) {
+        // request_stop() sets the stop flag before wakeup() writes to the eventfd. The write
+        // only fails if the eventfd counter is full, in which case a wakeup is pending anyway.
+        try {
+          __ring->request_stop();
+        } catch (...) {
+        }
+      }
+    }
+
+    void __stop_and_join() noexcept {
+      __request_stop_all();
+      for (auto& __worker: __threads_) {
+        if (__worker.joinable()) {
+          __worker.join();
+        }
+      }
+    }
+  };
+
+  inline thread_local io_uring_pool* io_uring_pool::__this_thread_pool_ = nullptr;
+  inline thread_local io_uring_context* io_uring_pool::__this_thread_ring_ = nullptr;
+} // namespace exec
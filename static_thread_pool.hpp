@@ -21,32 +21,197 @@
 #include "../stdexec/__detail/__config.hpp"
 #include "../stdexec/__detail/__intrusive_queue.hpp"
 #include "../stdexec/__detail/__meta.hpp"
+#include "../stdexec/__detail/__spin_loop_pause.hpp"
 #include "./__detail/__atomic_intrusive_queue.hpp"
 #include "./__detail/__bwos_lifo_queue.hpp"
 #include "./__detail/__manual_lifetime.hpp"
 #include "./__detail/__xorshift.hpp"
 #include "./__detail/__numa.hpp"
 
+#include "./bulk_reduce.hpp"
+#include "./bulk_scan.hpp"
 #include "./sequence_senders.hpp"
 #include "./sequence/iterate.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
 #include <span>
+#include <string>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#  include <charconv>
+#  include <fstream>
+
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+// Define STDEXEC_ENABLE_THREAD_POOL_METRICS to 1 to let every worker of a static_thread_pool
+// count what it does. The value must be the same in all translation units. If it is 0, the
+// counters compile to nothing and metrics() reports zeros.
+#ifndef STDEXEC_ENABLE_THREAD_POOL_METRICS
+#  define STDEXEC_ENABLE_THREAD_POOL_METRICS 0
+#endif
+
 namespace exec {
   struct bwos_params {
     std::size_t numBlocks{32};
     std::size_t blockSize{8};
   };
 
+  // What a worker does when it has run out of work to pop or steal.
+  enum class idle_strategy {
+    // Yield once, then sleep on a mutex and condition variable.
+    block,
+    // Spin for a while waiting to be notified, then park on the thread's state with
+    // std::atomic::wait. Waking a parked thread does not take a lock.
+    spin_then_park
+  };
+
+  struct idle_params {
+    idle_strategy strategy{idle_strategy::block};
+    // The number of __spin_loop_pause() rounds before a spin_then_park worker parks.
+    std::uint32_t spinCount{1024};
+  };
+
+  // How a bulk operation on a static_thread_pool hands out its indices.
+  enum class bulk_strategy {
+    // Every task gets an equal, contiguous share of the shape up front.
+    static_split,
+    // Tasks repeatedly claim chunks of `grain` indices from a shared counter.
+    dynamic,
+    // Like dynamic, but a chunk is a fraction of the remaining indices and shrinks down to
+    // `grain` as the bulk runs out of work.
+    guided
+  };
+
+  struct bulk_params {
+    bulk_strategy strategy{bulk_strategy::static_split};
+    // The smallest chunk of the dynamic and guided strategies.
+    std::size_t grain{1};
+  };
+
+  // Which cpus the workers of a static_thread_pool are pinned to. Worker i runs on the i-th
+  // cpu of the list, which wraps around if there are more workers than cpus. Pinning is only
+  // supported on Linux.
+  enum class pinning_strategy {
+    // Workers are only bound to their NUMA node by the numa_policy.
+    none,
+    // The cpus the process may run on, in ascending order.
+    compact,
+    // The cpus the process may run on, taking turns between the last level caches and using
+    // SMT siblings only after the first cpu of every core.
+    scatter,
+    // The first cpu of every core that the process may run on.
+    skip_smt_siblings,
+    // The cpus in /sys/devices/system/cpu/isolated. Workers are not pinned if there are none.
+    isolated,
+    // The cpus in thread_params::cpus.
+    cpu_list
+  };
+
+  struct thread_params {
+    pinning_strategy pinning{pinning_strategy::none};
+    std::vector<int> cpus{};
+    // If not empty, worker i is named namePrefix followed by i, e.g. for perf and top. Linux
+    // keeps 15 characters, so a long prefix is cut short.
+    std::string namePrefix{};
+  };
+
+  // Lets a static_thread_pool run fewer workers than its thread count while it is idle. The
+  // pool starts minThreads workers. A worker that has slept for idleTimeout exits, as long as
+  // minThreads workers remain. A worker is started again when work is enqueued to it, either
+  // because it was chosen while no running worker was idle or because the work is meant for it.
+  struct elastic_params {
+    // If not less than the thread count, the pool runs all its workers all the time.
+    std::uint32_t minThreads{std::numeric_limits<std::uint32_t>::max()};
+    std::chrono::milliseconds idleTimeout{1000};
+  };
+
+  // Where a static_thread_pool puts work that threads outside the pool submit.
+  struct injection_params {
+    // If true, unconstrained priority 0 work from outside the pool goes to one queue that all
+    // workers take from, rather than to the remote queues of a random worker. A worker takes
+    // from it when it runs out of work and, while it is busy, every fairnessInterval tasks.
+    bool enabled{false};
+    std::uint32_t fairnessInterval{61};
+  };
+
+  // The options of a static_thread_pool. Set only the members that differ from the defaults,
+  // e.g. `options.injection.enabled = true`.
+  struct static_thread_pool_params {
+    std::uint32_t threadCount{std::thread::hardware_concurrency()};
+    bwos_params bwos{};
+    // Has to outlive the pool. Workers bind to their node whenever they start, which in an
+    // elastic pool also happens long after construction. Null means get_numa_policy().
+    numa_policy* numa{nullptr};
+    idle_params idle{};
+    bulk_params bulk{};
+    thread_params threads{};
+    elastic_params elastic{};
+    injection_params injection{};
+  };
+
+  // A snapshot of the counters of one worker thread.
+  struct thread_metrics {
+    std::uint64_t tasksExecuted{0};
+    // Tasks taken from the worker's own BWoS queues or its next-task slot.
+    std::uint64_t localPops{0};
+    // Tasks taken after draining the worker's remote queues.
+    std::uint64_t remotePops{0};
+    // Steals from any level of the victim hierarchy but the last, which holds all threads.
+    std::uint64_t stealsNear{0};
+    std::uint64_t failedStealsNear{0};
+    std::uint64_t stealsAny{0};
+    std::uint64_t failedStealsAny{0};
+    std::uint64_t sleeps{0};
+    // Sleeps that ended because of a notify().
+    std::uint64_t wakeups{0};
+    std::chrono::nanoseconds timeAsleep{0};
+    // Tasks in the worker's remote queues that it has not picked up yet.
+    std::uint64_t remoteQueueDepth{0};
+  };
+
+  struct thread_pool_metrics {
+    std::vector<thread_metrics> threads{};
+
+    // Sums up the counters of all threads.
+    [[nodiscard]]
+    auto total() const noexcept -> thread_metrics {
+      thread_metrics sum{};
+      for (const thread_metrics& t: threads) {
+        sum.tasksExecuted += t.tasksExecuted;
+        sum.localPops += t.localPops;
+        sum.remotePops += t.remotePops;
+        sum.stealsNear += t.stealsNear;
+        sum.failedStealsNear += t.failedStealsNear;
+        sum.stealsAny += t.stealsAny;
+        sum.failedStealsAny += t.failedStealsAny;
+        sum.sleeps += t.sleeps;
+        sum.wakeups += t.wakeups;
+        sum.timeAsleep += t.timeAsleep;
+        sum.remoteQueueDepth += t.remoteQueueDepth;
+      }
+      return sum;
+    }
+  };
+
   namespace _pool_ {
     using namespace stdexec;
 
@@ -76,6 +241,176 @@ namespace exec {
       return std::make_pair(static_cast<Shape>(begin), static_cast<Shape>(end));
     }
 
+    // Returns the cpu of every worker, or nothing if the workers are not pinned.
+    inline auto pinned_cpus(
+      const thread_params& params,
+      std::uint32_t threadCount,
+      const cpu_topology& topology) -> std::vector<int> {
+      std::vector<int> cpus{};
+#if defined(__linux__)
+      std::vector<int> allowed{};
+      ::cpu_set_t mask;
+      CPU_ZERO(&mask);
+      if (::sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+          if (CPU_ISSET(cpu, &mask)) {
+            allowed.push_back(cpu);
+          }
+        }
+      }
+      // The lowest cpu of each group, or `cpu` itself if the topology does not know it.
+      auto core_of = [&](int cpu) {
+        return topology.core_of(cpu) < 0 ? cpu : topology.core_of(cpu);
+      };
+      auto cache_of = [&](int cpu) {
+        return topology.cache_of(cpu) < 0 ? cpu : topology.cache_of(cpu);
+      };
+
+      switch (params.pinning) {
+      case pinning_strategy::none:
+        break;
+      case pinning_strategy::compact:
+        cpus = allowed;
+        break;
+      case pinning_strategy::scatter: {
+        struct cache_cpus {
+          int first;
+          // The first cpu of every core, followed by the SMT siblings.
+          std::vector<int> cpus{};
+          std::size_t n_cores{0};
+        };
+        std::vector<cache_cpus> caches{};
+        std::vector<int> seen_cores{};
+        for (int cpu: allowed) {
+          auto it = std::find_if(caches.begin(), caches.end(), [&](const cache_cpus& cache) {
+            return cache.first == cache_of(cpu);
+          });
+          if (it == caches.end()) {
+            it = caches.insert(caches.end(), cache_cpus{cache_of(cpu)});
+          }
+          if (std::find(seen_cores.begin(), seen_cores.end(), core_of(cpu)) == seen_cores.end()) {
+            seen_cores.push_back(core_of(cpu));
+            it->cpus.insert(it->cpus.begin() + static_cast<std::ptrdiff_t>(it->n_cores++), cpu);
+          } else {
+            it->cpus.push_back(cpu);
+          }
+        }
+        for (std::size_t round = 0; cpus.size() < allowed.size(); ++round) {
+          for (const cache_cpus& cache: caches) {
+            if (round < cache.cpus.size()) {
+              cpus.push_back(cache.cpus[round]);
+            }
+          }
+        }
+        break;
+      }
+      case pinning_strategy::skip_smt_siblings: {
+        std::vector<int> seen_cores{};
+        for (int cpu: allowed) {
+          if (std::find(seen_cores.begin(), seen_cores.end(), core_of(cpu)) == seen_cores.end()) {
+            seen_cores.push_back(core_of(cpu));
+            cpus.push_back(cpu);
+          }
+        }
+        break;
+      }
+      case pinning_strategy::isolated: {
+        std::ifstream file("/sys/devices/system/cpu/isolated");
+        std::string list;
+        if (std::getline(file, list)) {
+          cpus = sysfs_numa_policy::parse_cpu_list(list);
+        }
+        break;
+      }
+      case pinning_strategy::cpu_list:
+        cpus = params.cpus;
+        break;
+      }
+
+      if (!cpus.empty()) {
+        std::vector<int> result(threadCount);
+        for (std::uint32_t i = 0; i < threadCount; ++i) {
+          result[i] = cpus[i % cpus.size()];
+        }
+        cpus = std::move(result);
+      }
+#endif
+      return cpus;
+    }
+
+    // Pins the calling thread to `cpu`. If that fails, the thread keeps its affinity.
+    inline void pin_this_thread([[maybe_unused]] int cpu) noexcept {
+#if defined(__linux__)
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return;
+      }
+      ::cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(cpu, &cpus);
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus);
+#endif
+    }
+
+    // Names the calling thread `prefix` followed by `index`. The prefix is cut short to fit the
+    // 15 characters that Linux keeps.
+    inline void name_this_thread(
+      [[maybe_unused]] const std::string& prefix,
+      [[maybe_unused]] std::uint32_t index) noexcept {
+#if defined(__linux__)
+      char digits[16];
+      auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), index);
+      const auto n_digits = static_cast<std::size_t>(end - digits);
+      const std::size_t n_prefix = std::min(prefix.size(), 15 - n_digits);
+      char name[16];
+      std::copy_n(prefix.data(), n_prefix, name);
+      std::copy_n(digits, n_digits, name + n_prefix);
+      name[n_prefix + n_digits] = '\0';
+      ::pthread_setname_np(::pthread_self(), name);
+#endif
+    }
+
+    class static_thread_pool_;
+
+    // The NUMA node of the calling thread if it is a worker of a static_thread_pool_, else -1.
+    inline thread_local int this_thread_numa_node = -1;
+
+    // The pool and index of the calling thread if it is a worker of a static_thread_pool_.
+    inline thread_local const static_thread_pool_* this_thread_pool = nullptr;
+    inline thread_local std::uint32_t this_thread_worker_index = 0;
+
+    // Allocates on the NUMA node of the static_thread_pool_ worker that calls allocate(), and on
+    // node 0 on any other thread. Memory can be deallocated on any thread, so all instances
+    // compare equal. In builds with STDEXEC_ENABLE_NUMA or STDEXEC_ENABLE_SYSFS_NUMA every
+    // allocation maps whole pages, which suits buffers better than small objects. Other builds
+    // allocate with std::allocator and do not place memory.
+    template <class T>
+    struct numa_local_allocator {
+      using value_type = T;
+
+      numa_local_allocator() = default;
+
+      template <class U>
+      numa_local_allocator(const numa_local_allocator<U>&) noexcept {
+      }
+
+      auto allocate(std::size_t n) -> T* {
+        T* p = numa_allocator<T>(std::max(this_thread_numa_node, 0)).allocate(n);
+        if (p == nullptr) {
+          throw std::bad_alloc();
+        }
+        return p;
+      }
+
+      void deallocate(T* p, std::size_t n) noexcept {
+        numa_allocator<T>(0).deallocate(p, n);
+      }
+
+      friend auto
+        operator==(const numa_local_allocator&, const numa_local_allocator&) noexcept -> bool {
+        return true;
+      }
+    };
+
 #if STDEXEC_HAS_STD_RANGES()
     namespace schedule_all_ {
       template <class Range>
@@ -95,72 +430,264 @@ namespace exec {
       void (*__execute)(task_base*, std::uint32_t tid) noexcept;
     };
 
+    // The counters behind thread_metrics. Every counter but the remote enqueue count is only
+    // written by its worker thread, so a relaxed load and store is enough to update it.
+    template <bool Enabled>
+    class thread_counters {
+      using counter = std::atomic<std::uint64_t>;
+
+      static void bump(counter& c, std::uint64_t n = 1) noexcept {
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+      }
+
+      counter tasksExecuted_{0};
+      counter localPops_{0};
+      counter remotePops_{0};
+      counter stealsNear_{0};
+      counter failedStealsNear_{0};
+      counter stealsAny_{0};
+      counter failedStealsAny_{0};
+      counter sleeps_{0};
+      counter wakeups_{0};
+      counter nsAsleep_{0};
+      counter remoteDequeued_{0};
+      alignas(64) counter remoteEnqueued_{0};
+
+     public:
+      using clock = std::chrono::steady_clock;
+
+      void on_execute() noexcept {
+        bump(tasksExecuted_);
+      }
+
+      void on_local_pop() noexcept {
+        bump(localPops_);
+      }
+
+      void on_remote_pop() noexcept {
+        bump(remotePops_);
+      }
+
+      void on_steal(bool near, bool success) noexcept {
+        if (near) {
+          bump(success ? stealsNear_ : failedStealsNear_);
+        } else {
+          bump(success ? stealsAny_ : failedStealsAny_);
+        }
+      }
+
+      void on_remote_enqueue(std::uint64_t n) noexcept {
+        remoteEnqueued_.fetch_add(n, std::memory_order_relaxed);
+      }
+
+      void on_remote_dequeue(const __intrusive_queue<&task_base::next>& tasks) noexcept {
+        std::uint64_t n = 0;
+        for ([[maybe_unused]] task_base* t: tasks) {
+          ++n;
+        }
+        bump(remoteDequeued_, n);
+      }
+
+      [[nodiscard]]
+      auto sleep_begin() const noexcept -> clock::time_point {
+        return clock::now();
+      }
+
+      void sleep_end(clock::time_point start, bool notified) noexcept {
+        bump(sleeps_);
+        if (notified) {
+          bump(wakeups_);
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+        bump(nsAsleep_, static_cast<std::uint64_t>(ns.count()));
+      }
+
+      [[nodiscard]]
+      auto snapshot() const noexcept -> thread_metrics {
+        const std::uint64_t dequeued = remoteDequeued_.load(std::memory_order_relaxed);
+        const std::uint64_t enqueued = remoteEnqueued_.load(std::memory_order_relaxed);
+        return thread_metrics{
+          .tasksExecuted = tasksExecuted_.load(std::memory_order_relaxed),
+          .localPops = localPops_.load(std::memory_order_relaxed),
+          .remotePops = remotePops_.load(std::memory_order_relaxed),
+          .stealsNear = stealsNear_.load(std::memory_order_relaxed),
+          .failedStealsNear = failedStealsNear_.load(std::memory_order_relaxed),
+          .stealsAny = stealsAny_.load(std::memory_order_relaxed),
+          .failedStealsAny = failedStealsAny_.load(std::memory_order_relaxed),
+          .sleeps = sleeps_.load(std::memory_order_relaxed),
+          .wakeups = wakeups_.load(std::memory_order_relaxed),
+          .timeAsleep = std::chrono::nanoseconds(nsAsleep_.load(std::memory_order_relaxed)),
+          .remoteQueueDepth = enqueued > dequeued ? enqueued - dequeued : 0};
+      }
+    };
+
+    template <>
+    class thread_counters<false> {
+     public:
+      struct clock {
+        struct time_point { };
+      };
+
+      void on_execute() noexcept {
+      }
+
+      void on_local_pop() noexcept {
+      }
+
+      void on_remote_pop() noexcept {
+      }
+
+      void on_steal(bool, bool) noexcept {
+      }
+
+      void on_remote_enqueue(std::uint64_t) noexcept {
+      }
+
+      void on_remote_dequeue(const __intrusive_queue<&task_base::next>&) noexcept {
+      }
+
+      [[nodiscard]]
+      auto sleep_begin() const noexcept -> clock::time_point {
+        return {};
+      }
+
+      void sleep_end(clock::time_point, bool) noexcept {
+      }
+
+      [[nodiscard]]
+      auto snapshot() const noexcept -> thread_metrics {
+        return {};
+      }
+    };
+
+    // The bits of the remote queue slots that may hold tasks for one worker.
+    struct alignas(64) pending_slots {
+      std::atomic<std::uint64_t> mask_{0};
+    };
+
+    // One slot of remote queues with a queue for each worker. Every submitting thread maps to
+    // a slot. Threads that map to the same slot share it, since its queues take any number of
+    // producers.
     struct remote_queue {
-      explicit remote_queue(std::size_t nthreads) noexcept
-        : queues_(nthreads) {
+      explicit remote_queue(std::size_t nthreads, std::size_t slot, pending_slots* pending) noexcept
+        : queues_(nthreads)
+        , bit_(std::uint64_t{1} << slot)
+        , pending_(pending) {
       }
 
-      explicit remote_queue(remote_queue* next, std::size_t nthreads) noexcept
-        : next_(next)
-        , queues_(nthreads) {
+      void push_front(std::size_t tid, task_base* task) noexcept {
+        queues_[tid].push_front(task);
+        pending_[tid].mask_.fetch_or(bit_, std::memory_order_release);
+      }
+
+      void prepend(std::size_t tid, __intrusive_queue<&task_base::next> tasks) noexcept {
+        queues_[tid].prepend(std::move(tasks));
+        pending_[tid].mask_.fetch_or(bit_, std::memory_order_release);
       }
 
-      remote_queue* next_{};
       std::vector<__atomic_intrusive_queue<&task_base::next>> queues_{};
-      std::thread::id id_{std::this_thread::get_id()};
-      // This marks whether the submitter is a thread in the pool or not.
-      std::size_t index_{std::numeric_limits<std::size_t>::max()};
+      std::uint64_t bit_;
+      pending_slots* pending_;
     };
 
+    // Gives every thread a slot number when it first submits to any pool.
+    inline auto this_thread_remote_slot() noexcept -> std::size_t {
+      static std::atomic<std::size_t> next_slot{0};
+      thread_local std::size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+      return slot;
+    }
+
+    // A fixed number of remote queue slots. Finding the slot of a thread takes a thread_local
+    // lookup, and a worker only visits the slots whose bit is set in its pending mask. Slots
+    // belong to the pool rather than to a thread, so nothing is left behind when a thread exits.
     struct remote_queue_list {
+      static constexpr std::size_t max_slots = 64;
+
      private:
-      std::atomic<remote_queue*> head_;
-      remote_queue* tail_;
-      std::size_t nthreads_;
-      remote_queue this_remotes_;
+      std::vector<pending_slots> pending_;
+      std::vector<remote_queue> slots_;
 
      public:
-      explicit remote_queue_list(std::size_t nthreads) noexcept
-        : head_{&this_remotes_}
-        , tail_{&this_remotes_}
-        , nthreads_(nthreads)
-        , this_remotes_(nthreads) {
-      }
-
-      ~remote_queue_list() noexcept {
-        remote_queue* head = head_.load(std::memory_order_acquire);
-        while (head != tail_) {
-          remote_queue* tmp = std::exchange(head, head->next_);
-          delete tmp;
+      explicit remote_queue_list(std::size_t nthreads)
+        : pending_(nthreads) {
+        slots_.reserve(max_slots);
+        for (std::size_t slot = 0; slot < max_slots; ++slot) {
+          slots_.emplace_back(nthreads, slot, pending_.data());
         }
       }
 
       auto pop_all_reversed(std::size_t tid) noexcept -> __intrusive_queue<&task_base::next> {
-        remote_queue* head = head_.load(std::memory_order_acquire);
         __intrusive_queue<&task_base::next> tasks{};
-        while (head != nullptr) {
-          tasks.append(head->queues_[tid].pop_all_reversed());
-          head = head->next_;
+        std::uint64_t mask = pending_[tid].mask_.exchange(0, std::memory_order_acquire);
+        while (mask != 0) {
+          const auto slot = static_cast<std::size_t>(std::countr_zero(mask));
+          mask &= mask - 1;
+          tasks.append(slots_[slot].queues_[tid].pop_all_reversed());
         }
         return tasks;
       }
 
-      auto get() -> remote_queue* {
-        thread_local std::thread::id this_id = std::this_thread::get_id();
-        remote_queue* head = head_.load(std::memory_order_acquire);
-        remote_queue* queue = head;
-        while (queue != tail_) {
-          if (queue->id_ == this_id) {
-            return queue;
-          }
-          queue = queue->next_;
+      auto get() noexcept -> remote_queue* {
+        return &slots_[this_thread_remote_slot() % max_slots];
+      }
+    };
+
+    // A queue of tasks that any worker may take from. It backs injection_params and the
+    // overflow of every worker's BWoS queue. A taker gets a share of the tasks at once, and
+    // checks the size without the lock first, so that polling an empty queue stays cheap.
+    class shared_task_queue {
+      static auto count(const __intrusive_queue<&task_base::next>& tasks) noexcept -> std::size_t {
+        std::size_t n = 0;
+        for ([[maybe_unused]] task_base* t: tasks) {
+          ++n;
         }
-        auto* new_head = new remote_queue{head, nthreads_};
-        while (!head_.compare_exchange_weak(head, new_head, std::memory_order_acq_rel)) {
-          new_head->next_ = head;
+        return n;
+      }
+
+     public:
+      void push(task_base* task) noexcept {
+        std::lock_guard lock{mut_};
+        tasks_.push_back(task);
+        size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      }
+
+      // Puts `tasks` in front of the queue, so that they are taken first.
+      void prepend(__intrusive_queue<&task_base::next> tasks) noexcept {
+        if (tasks.empty()) {
+          return;
         }
-        return new_head;
+        const std::size_t n = count(tasks);
+        std::lock_guard lock{mut_};
+        tasks_.prepend(std::move(tasks));
+        size_.store(size_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+      }
+
+      [[nodiscard]]
+      auto empty() const noexcept -> bool {
+        return size_.load(std::memory_order_relaxed) == 0;
       }
+
+      // Takes size / nshares + 1 tasks, but at most `max` and at least one, if there are any.
+      auto pop(std::size_t nshares, std::size_t max) noexcept
+        -> __intrusive_queue<&task_base::next> {
+        __intrusive_queue<&task_base::next> tasks{};
+        if (empty()) {
+          return tasks;
+        }
+        std::lock_guard lock{mut_};
+        const std::size_t size = size_.load(std::memory_order_relaxed);
+        const std::size_t n = std::min({size, size / nshares + 1, std::max<std::size_t>(max, 1)});
+        for (std::size_t i = 0; i < n; ++i) {
+          tasks.push_back(tasks_.pop_front());
+        }
+        size_.store(size - n, std::memory_order_relaxed);
+        return tasks;
+      }
+
+     private:
+      std::mutex mut_{};
+      __intrusive_queue<&task_base::next> tasks_{};
+      std::atomic<std::size_t> size_{0};
     };
 
     class static_thread_pool_ {
@@ -233,12 +760,112 @@ namespace exec {
       using bulk_op_state_t =
         __t<bulk_op_state<__id<__decay_t<Sender>>, __id<__decay_t<Receiver>>, Shape, Fun>>;
 
+      template <class SenderId, std::integral Shape, class Init, class Map, class Reduce>
+      struct bulk_reduce_sender {
+        using Sender = stdexec::__t<SenderId>;
+        struct __t;
+      };
+
+      template <sender Sender, std::integral Shape, class Init, class Map, class Reduce>
+      using bulk_reduce_sender_t =
+        __t<bulk_reduce_sender<__id<__decay_t<Sender>>, Shape, Init, Map, Reduce>>;
+
+      template <
+        class CvrefSenderId,
+        class ReceiverId,
+        std::integral Shape,
+        class Init,
+        class Map,
+        class Reduce>
+      struct bulk_reduce_op_state {
+        using CvrefSender = stdexec::__cvref_t<CvrefSenderId>;
+        using Receiver = stdexec::__t<ReceiverId>;
+        struct __t;
+      };
+
+      template <
+        class SenderId,
+        std::integral Shape,
+        class InIt,
+        class OutIt,
+        class Tp,
+        class Op>
+      struct bulk_scan_sender {
+        using Sender = stdexec::__t<SenderId>;
+        struct __t;
+      };
+
+      template <
+        sender Sender,
+        std::integral Shape,
+        class InIt,
+        class OutIt,
+        class Tp,
+        class Op>
+      using bulk_scan_sender_t =
+        __t<bulk_scan_sender<__id<__decay_t<Sender>>, Shape, InIt, OutIt, Tp, Op>>;
+
+      template <
+        class CvrefSenderId,
+        class ReceiverId,
+        std::integral Shape,
+        class InIt,
+        class OutIt,
+        class Tp,
+        class Op>
+      struct bulk_scan_op_state {
+        using CvrefSender = stdexec::__cvref_t<CvrefSenderId>;
+        using Receiver = stdexec::__t<ReceiverId>;
+        struct __t;
+      };
+
       struct transform_bulk {
         template <class Data, class Sender>
         auto operator()(bulk_t, Data&& data, Sender&& sndr) {
           auto [shape, fun] = static_cast<Data&&>(data);
           return bulk_sender_t<Sender, decltype(shape), decltype(fun)>{
-            pool_, static_cast<Sender&&>(sndr), shape, std::move(fun)};
+            pool_, static_cast<Sender&&>(sndr), shape, std::move(fun), constraints_};
+        }
+
+        static_thread_pool_& pool_;
+        nodemask constraints_;
+      };
+
+      struct transform_bulk_reduce {
+        template <class Data, class Sender>
+        auto operator()(exec::bulk_reduce_t, Data&& data, Sender&& sndr) {
+          auto [shape, init, map, reduce] = static_cast<Data&&>(data);
+          return bulk_reduce_sender_t<
+            Sender,
+            decltype(shape),
+            decltype(init),
+            decltype(map),
+            decltype(reduce)>{
+            pool_, static_cast<Sender&&>(sndr), shape, std::move(init), std::move(map), std::move(reduce)};
+        }
+
+        static_thread_pool_& pool_;
+      };
+
+      struct transform_bulk_scan {
+        template <class Data, class Sender>
+        auto operator()(exec::bulk_scan_t, Data&& data, Sender&& sndr) {
+          auto [shape, input, output, init, op, kind] = static_cast<Data&&>(data);
+          return bulk_scan_sender_t<
+            Sender,
+            decltype(shape),
+            decltype(input),
+            decltype(output),
+            decltype(init),
+            decltype(op)>{
+            pool_,
+            static_cast<Sender&&>(sndr),
+            shape,
+            std::move(input),
+            std::move(output),
+            std::move(init),
+            std::move(op),
+            kind};
         }
 
         static_thread_pool_& pool_;
@@ -262,7 +889,7 @@ namespace exec {
         auto transform_sender(Sender&& sndr) const noexcept {
           if constexpr (__completes_on<Sender, static_thread_pool_::scheduler>) {
             auto sched = get_completion_scheduler<set_value_t>(get_env(sndr));
-            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk{*sched.pool_});
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk{*sched.pool_, sched.nodemask_});
           } else {
             static_assert(
               __completes_on<Sender, static_thread_pool_::scheduler>,
@@ -277,10 +904,10 @@ namespace exec {
         auto transform_sender(Sender&& sndr, const Env& env) const noexcept {
           if constexpr (__completes_on<Sender, static_thread_pool_::scheduler>) {
             auto sched = get_completion_scheduler<set_value_t>(get_env(sndr));
-            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk{*sched.pool_});
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk{*sched.pool_, sched.nodemask_});
           } else if constexpr (__starts_on<Sender, static_thread_pool_::scheduler, Env>) {
             auto sched = stdexec::get_scheduler(env);
-            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk{*sched.pool_});
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk{*sched.pool_, sched.nodemask_});
           } else {
             static_assert( //
               __starts_on<Sender, static_thread_pool_::scheduler, Env>
@@ -291,6 +918,70 @@ namespace exec {
           }
         }
 
+        template <sender_expr_for<exec::bulk_reduce_t> Sender>
+        auto transform_sender(Sender&& sndr) const noexcept {
+          if constexpr (__completes_on<Sender, static_thread_pool_::scheduler>) {
+            auto sched = get_completion_scheduler<set_value_t>(get_env(sndr));
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk_reduce{*sched.pool_});
+          } else {
+            static_assert(
+              __completes_on<Sender, static_thread_pool_::scheduler>,
+              "No static_thread_pool_ instance can be found in the sender's environment "
+              "on which to schedule bulk_reduce work.");
+            return not_a_sender<__name_of<Sender>>();
+          }
+        }
+
+        template <sender_expr_for<exec::bulk_reduce_t> Sender, class Env>
+        auto transform_sender(Sender&& sndr, const Env& env) const noexcept {
+          if constexpr (__completes_on<Sender, static_thread_pool_::scheduler>) {
+            auto sched = get_completion_scheduler<set_value_t>(get_env(sndr));
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk_reduce{*sched.pool_});
+          } else if constexpr (__starts_on<Sender, static_thread_pool_::scheduler, Env>) {
+            auto sched = stdexec::get_scheduler(env);
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk_reduce{*sched.pool_});
+          } else {
+            static_assert( //
+              __starts_on<Sender, static_thread_pool_::scheduler, Env>
+                || __completes_on<Sender, static_thread_pool_::scheduler>,
+              "No static_thread_pool_ instance can be found in the sender's or receiver's "
+              "environment on which to schedule bulk_reduce work.");
+            return not_a_sender<__name_of<Sender>>();
+          }
+        }
+
+        template <sender_expr_for<exec::bulk_scan_t> Sender>
+        auto transform_sender(Sender&& sndr) const noexcept {
+          if constexpr (__completes_on<Sender, static_thread_pool_::scheduler>) {
+            auto sched = get_completion_scheduler<set_value_t>(get_env(sndr));
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk_scan{*sched.pool_});
+          } else {
+            static_assert(
+              __completes_on<Sender, static_thread_pool_::scheduler>,
+              "No static_thread_pool_ instance can be found in the sender's environment "
+              "on which to schedule bulk_scan work.");
+            return not_a_sender<__name_of<Sender>>();
+          }
+        }
+
+        template <sender_expr_for<exec::bulk_scan_t> Sender, class Env>
+        auto transform_sender(Sender&& sndr, const Env& env) const noexcept {
+          if constexpr (__completes_on<Sender, static_thread_pool_::scheduler>) {
+            auto sched = get_completion_scheduler<set_value_t>(get_env(sndr));
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk_scan{*sched.pool_});
+          } else if constexpr (__starts_on<Sender, static_thread_pool_::scheduler, Env>) {
+            auto sched = stdexec::get_scheduler(env);
+            return __sexpr_apply(static_cast<Sender&&>(sndr), transform_bulk_scan{*sched.pool_});
+          } else {
+            static_assert( //
+              __starts_on<Sender, static_thread_pool_::scheduler, Env>
+                || __completes_on<Sender, static_thread_pool_::scheduler>,
+              "No static_thread_pool_ instance can be found in the sender's or receiver's "
+              "environment on which to schedule bulk_scan work.");
+            return not_a_sender<__name_of<Sender>>();
+          }
+        }
+
 #if STDEXEC_HAS_STD_RANGES()
         template <sender_expr_for<exec::iterate_t> Sender>
         auto transform_sender(Sender&& sndr) const noexcept {
@@ -308,13 +999,25 @@ namespace exec {
       };
 
      public:
+      // Tasks of a higher priority are popped and stolen before tasks of a lower one. Priority
+      // 0 is the default.
+      static constexpr std::uint32_t max_priority = 2;
+
+      // The number of tasks a worker runs from its next-task slot before it looks at its other
+      // queues. It keeps a chain of continuations from starving older and remote work.
+      static constexpr std::uint32_t max_next_pops = 3;
+
       static_thread_pool_();
+      // `numa` has to outlive the pool, see static_thread_pool_params::numa.
       static_thread_pool_(
         std::uint32_t threadCount,
         bwos_params params = {},
         numa_policy* numa = get_numa_policy());
+      explicit static_thread_pool_(static_thread_pool_params options);
       ~static_thread_pool_();
 
+      class submission_batch;
+
       struct scheduler {
         using __t = scheduler;
         using __id = scheduler;
@@ -338,7 +1041,13 @@ namespace exec {
           template <typename Receiver>
           auto make_operation_(Receiver rcvr) const -> operation_t<Receiver> {
             return operation_t<Receiver>{
-              pool_, queue_, static_cast<Receiver&&>(rcvr), threadIndex_, constraints_};
+              pool_,
+              queue_,
+              static_cast<Receiver&&>(rcvr),
+              threadIndex_,
+              constraints_,
+              priority_,
+              batch_};
           }
 
           template <receiver Receiver>
@@ -349,6 +1058,8 @@ namespace exec {
           struct env {
             static_thread_pool_& pool_;
             remote_queue* queue_;
+            nodemask constraints_;
+            std::uint32_t priority_;
 
             template <class CPO>
             STDEXEC_MEMFN_DECL(auto query)(this const env& self, get_completion_scheduler_t<CPO>) noexcept
@@ -356,14 +1067,21 @@ namespace exec {
               return self.make_scheduler_();
             }
 
+            STDEXEC_MEMFN_DECL(auto query)(this const env&, get_allocator_t) noexcept
+              -> numa_local_allocator<std::byte> {
+              return {};
+            }
+
             [[nodiscard]]
             auto make_scheduler_() const -> static_thread_pool_::scheduler {
-              return static_thread_pool_::scheduler{pool_, *queue_};
+              static_thread_pool_::scheduler sched{pool_, *queue_, constraints_};
+              sched.priority_ = priority_;
+              return sched;
             }
           };
 
           STDEXEC_MEMFN_DECL(auto get_env)(this const sender& self) noexcept -> env {
-            return env{self.pool_, self.queue_};
+            return env{self.pool_, self.queue_, self.constraints_, self.priority_};
           }
 
           friend struct static_thread_pool_::scheduler;
@@ -372,22 +1090,28 @@ namespace exec {
             static_thread_pool_& pool,
             remote_queue* queue,
             std::size_t threadIndex,
-            const nodemask& constraints) noexcept
+            const nodemask& constraints,
+            std::uint32_t priority,
+            submission_batch* batch) noexcept
             : pool_(pool)
             , queue_(queue)
             , threadIndex_(threadIndex)
-            , constraints_(constraints) {
+            , constraints_(constraints)
+            , priority_(priority)
+            , batch_(batch) {
           }
 
           static_thread_pool_& pool_;
           remote_queue* queue_;
           std::size_t threadIndex_{std::numeric_limits<std::size_t>::max()};
           nodemask constraints_{};
+          std::uint32_t priority_{0};
+          submission_batch* batch_{nullptr};
         };
 
         [[nodiscard]]
         auto make_sender_() const -> sender {
-          return sender{*pool_, queue_, thread_idx_, nodemask_};
+          return sender{*pool_, queue_, thread_idx_, nodemask_, priority_, batch_};
         }
 
         STDEXEC_MEMFN_DECL(auto schedule)(this const scheduler& sch) noexcept -> sender {
@@ -403,6 +1127,12 @@ namespace exec {
           return {};
         }
 
+        // Work that runs on the pool allocates on the NUMA node of the thread that runs it.
+        STDEXEC_MEMFN_DECL(auto query)(this const scheduler&, get_allocator_t) noexcept
+          -> numa_local_allocator<std::byte> {
+          return {};
+        }
+
         friend class static_thread_pool_;
 
         explicit scheduler(
@@ -435,12 +1165,98 @@ namespace exec {
         remote_queue* queue_;
         nodemask nodemask_;
         std::size_t thread_idx_{std::numeric_limits<std::size_t>::max()};
+        std::uint32_t priority_{0};
+        // Operations of a scheduler from submission_batch::get_scheduler() join the batch.
+        submission_batch* batch_{nullptr};
+      };
+
+      // Collects the operations started on its scheduler and hands them to the pool at once.
+      // submit() splits them evenly between the workers with one push and one notify() per
+      // worker, where enqueuing them one by one takes both for every operation. The batch is
+      // submitted when it is destroyed. Operations started after submit() are enqueued one by
+      // one. Batched operations run with priority 0 on any node.
+      //
+      // Operations may be started on the scheduler of a batch from several threads at once, and
+      // concurrently with submit(). A mutex guards the collected operations. The scheduler must
+      // not be used after the batch is destroyed.
+      class submission_batch {
+       public:
+        explicit submission_batch(static_thread_pool_& pool) noexcept
+          : pool_(&pool) {
+        }
+
+        submission_batch(submission_batch&&) = delete;
+
+        ~submission_batch() {
+          submit();
+        }
+
+        // Completions of its senders run on the pool's scheduler.
+        auto get_scheduler() noexcept -> scheduler {
+          scheduler sched{*pool_};
+          sched.batch_ = this;
+          return sched;
+        }
+
+        void submit() noexcept {
+          __intrusive_queue<&task_base::next> tasks{};
+          std::size_t size = 0;
+          {
+            std::lock_guard lock{mut_};
+            submitted_ = true;
+            tasks = std::move(tasks_);
+            tasks_ = {};
+            std::swap(size, size_);
+          }
+          if (size != 0) {
+            pool_->bulk_enqueue(*pool_->get_remote_queue(), std::move(tasks), size);
+          }
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept -> std::size_t {
+          std::lock_guard lock{mut_};
+          return size_;
+        }
+
+       private:
+        template <class ReceiverId>
+        friend struct operation;
+
+        // Returns false once the batch has been submitted.
+        auto push(task_base* task) noexcept -> bool {
+          std::lock_guard lock{mut_};
+          if (submitted_) {
+            return false;
+          }
+          tasks_.push_back(task);
+          ++size_;
+          return true;
+        }
+
+        static_thread_pool_* pool_;
+        mutable std::mutex mut_;
+        __intrusive_queue<&task_base::next> tasks_{};
+        std::size_t size_{0};
+        bool submitted_{false};
       };
 
       auto get_scheduler() noexcept -> scheduler {
         return scheduler{*this};
       }
 
+      auto make_submission_batch() noexcept -> submission_batch {
+        return submission_batch{*this};
+      }
+
+      // Returns a scheduler whose tasks go to the priority lane `priority`, which is clamped to
+      // max_priority.
+      auto get_scheduler_with_priority(std::uint32_t priority) noexcept -> scheduler {
+        scheduler sched{*this};
+        sched.priority_ = std::min(priority, max_priority);
+        return sched;
+      }
+
       auto get_scheduler_on_thread(std::size_t threadIndex) noexcept -> scheduler {
         return scheduler{*this, *get_remote_queue(), threadIndex};
       }
@@ -450,17 +1266,7 @@ namespace exec {
       }
 
       auto get_remote_queue() noexcept -> remote_queue* {
-        remote_queue* queue = remotes_.get();
-        std::size_t index = 0;
-        for (std::thread& t: threads_) {
-          if (t.get_id() == queue->id_) {
-            queue->index_ = index;
-            break;
-          }
-
-          ++index;
-        }
-        return queue;
+        return remotes_.get();
       }
 
       void request_stop() noexcept;
@@ -475,15 +1281,55 @@ namespace exec {
         return params_;
       }
 
+      // Returns the number of workers that are running. It is available_parallelism() unless
+      // the pool is elastic.
+      [[nodiscard]]
+      auto live_threads() const noexcept -> std::uint32_t {
+        return liveThreads_.load(std::memory_order_relaxed);
+      }
+
+      // Returns a snapshot of the counters of every worker thread.
+      [[nodiscard]]
+      auto metrics() const -> thread_pool_metrics {
+        thread_pool_metrics result{};
+        result.threads.reserve(threadStates_.size());
+        for (const auto& state: threadStates_) {
+          result.threads.push_back(state->counters_snapshot());
+        }
+        return result;
+      }
+
       void enqueue(task_base* task, const nodemask& contraints = nodemask::any()) noexcept;
       void enqueue(
         remote_queue& queue,
         task_base* task,
-        const nodemask& contraints = nodemask::any()) noexcept;
-      void enqueue(remote_queue& queue, task_base* task, std::size_t threadIndex) noexcept;
+        const nodemask& contraints = nodemask::any(),
+        std::uint32_t priority = 0) noexcept;
+      void enqueue(
+        remote_queue& queue,
+        task_base* task,
+        std::size_t threadIndex,
+        std::uint32_t priority = 0) noexcept;
+
+      // The `n_threads` tasks of a bulk operation form an implicit tree in which task i has the
+      // children bulk_fan_out * i + 1, ..., bulk_fan_out * i + bulk_fan_out. bulk_enqueue()
+      // only enqueues the root. Every task enqueues its children with bulk_enqueue_children()
+      // before it does its own work. No thread enqueues and wakes more than bulk_fan_out tasks.
+      // The tasks go to the overflow of their threads, where other workers can steal them, so a
+      // busy thread does not hold back its part of the tree.
+      static constexpr std::uint32_t bulk_fan_out = 4;
 
       template <std::derived_from<task_base> TaskT>
-      void bulk_enqueue(TaskT* task, std::uint32_t n_threads) noexcept;
+      void bulk_enqueue(
+        TaskT* task,
+        std::uint32_t n_threads,
+        const nodemask& constraints = nodemask::any()) noexcept;
+      template <std::derived_from<task_base> TaskT>
+      void bulk_enqueue_children(
+        TaskT* tasks,
+        std::uint32_t index,
+        std::uint32_t n_threads,
+        const nodemask& constraints = nodemask::any()) noexcept;
       void bulk_enqueue(
         remote_queue& queue,
         __intrusive_queue<&task_base::next> tasks,
@@ -491,19 +1337,48 @@ namespace exec {
         const nodemask& constraints = nodemask::any()) noexcept;
 
      private:
+      using local_queue_t = bwos::lifo_queue<task_base*, numa_allocator<task_base*>>;
+
       class workstealing_victim {
        public:
+        // queues[p] is the victim's local queue of priority p.
         explicit workstealing_victim(
-          bwos::lifo_queue<task_base*, numa_allocator<task_base*>>* queue,
+          std::array<local_queue_t*, max_priority + 1> queues,
+          std::atomic<task_base*>* next,
+          shared_task_queue* overflow,
           std::uint32_t index,
-          int numa_node) noexcept
-          : queue_(queue)
+          int numa_node,
+          int cpu) noexcept
+          : queues_(queues)
+          , next_(next)
+          , overflow_(overflow)
           , index_(index)
-          , numa_node_(numa_node) {
+          , numa_node_(numa_node)
+          , cpu_(cpu) {
         }
 
         auto try_steal() noexcept -> task_base* {
-          return queue_->steal_front();
+          for (std::size_t p = queues_.size(); p > 0; --p) {
+            if (task_base* task = queues_[p - 1]->steal_front()) {
+              return task;
+            }
+          }
+          return nullptr;
+        }
+
+        // Takes half of the tasks that did not fit into the victim's BWoS queue, but at most
+        // `max`.
+        auto try_steal_overflow(std::size_t max) noexcept -> __intrusive_queue<&task_base::next> {
+          return overflow_->pop(2, max);
+        }
+
+        // Takes the task in the victim's next-task slot. Only a thief that is about to go idle
+        // calls this, so that a continuation does not wait behind a long task of its worker.
+        auto try_steal_next() noexcept -> task_base* {
+          if (next_->load(std::memory_order_relaxed) == nullptr) {
+            return nullptr;
+          }
+          return next_->exchange(nullptr, std::memory_order_acquire);
         }
 
         [[nodiscard]]
@@ -516,20 +1391,34 @@ namespace exec {
           return numa_node_;
         }
 
+        [[nodiscard]]
+        auto cpu() const noexcept -> int {
+          return cpu_;
+        }
+
        private:
-        bwos::lifo_queue<task_base*, numa_allocator<task_base*>>* queue_;
+        std::array<local_queue_t*, max_priority + 1> queues_;
+        std::atomic<task_base*>* next_;
+        shared_task_queue* overflow_;
         std::uint32_t index_;
         int numa_node_;
+        int cpu_;
       };
 
       struct thread_state_base {
-        explicit thread_state_base(std::uint32_t index, numa_policy* numa) noexcept
+        // A pinned worker belongs to the node of its cpu, if the policy knows it.
+        explicit thread_state_base(std::uint32_t index, numa_policy* numa, int pinnedCpu) noexcept
           : index_(index)
-          , numa_node_(numa->thread_index_to_node(index)) {
+          , numa_node_(
+              pinnedCpu >= 0 && numa->cpu_to_node(pinnedCpu) >= 0
+                ? numa->cpu_to_node(pinnedCpu)
+                : numa->thread_index_to_node(index))
+          , cpu_(pinnedCpu >= 0 ? pinnedCpu : numa->thread_index_to_cpu(index)) {
         }
 
         std::uint32_t index_;
         int numa_node_;
+        int cpu_;
       };
 
       class thread_state : private thread_state_base {
@@ -543,12 +1432,17 @@ namespace exec {
           static_thread_pool_* pool,
           std::uint32_t index,
           bwos_params params,
-          numa_policy* numa) noexcept
-          : thread_state_base(index, numa)
+          numa_policy* numa,
+          int pinnedCpu) noexcept
+          : thread_state_base(index, numa, pinnedCpu)
           , local_queue_(
               params.numBlocks,
               params.blockSize,
               numa_allocator<task_base*>(this->numa_node_))
+          , priority_lanes_(make_priority_lanes(
+              params,
+              this->numa_node_,
+              std::make_index_sequence<max_priority>{}))
           , state_(state::running)
           , pool_(pool) {
           std::random_device rd;
@@ -556,22 +1450,74 @@ namespace exec {
         }
 
         auto pop() -> pop_result;
-        void push_local(task_base* task);
+        void push_local(task_base* task, std::uint32_t priority = 0);
+        void push_next(task_base* task);
         void push_local(__intrusive_queue<&task_base::next>&& tasks);
+        void push_remote(task_base* task, std::uint32_t priority) noexcept;
+        void push_stealable(task_base* task) noexcept;
 
         auto notify() -> bool;
         void request_stop();
 
-        void victims(const std::vector<workstealing_victim>& victims) {
+        // A retired worker has no thread. Only the worker itself retires, and only from sleep,
+        // so its queues are empty when it does.
+        [[nodiscard]]
+        auto is_retired() const noexcept -> bool {
+          return state_.load(std::memory_order_relaxed) == state::retired;
+        }
+
+        void set_retired() noexcept {
+          state_.store(state::retired, std::memory_order_relaxed);
+        }
+
+        // Returns true in the one caller that brings the worker back from retirement.
+        auto try_revive() noexcept -> bool {
+          state expected = state::retired;
+          return state_.compare_exchange_strong(expected, state::running, std::memory_order_relaxed);
+        }
+
+        void clear_retiring() noexcept {
+          retiring_ = false;
+        }
+
+        auto counters() noexcept -> thread_counters<STDEXEC_ENABLE_THREAD_POOL_METRICS != 0>& {
+          return counters_;
+        }
+
+        [[nodiscard]]
+        auto counters_snapshot() const noexcept -> thread_metrics {
+          return counters_.snapshot();
+        }
+
+        // Sorts the victims into levels of increasing distance: SMT siblings, threads that
+        // share the last level cache, threads on the same NUMA node, and all threads. Each level
+        // includes the closer ones. Levels that are empty or add no victim are left out.
+        void victims(const std::vector<workstealing_victim>& victims, const cpu_topology& topology) {
+          constexpr std::size_t n_levels = 4;
+          auto distance = [&](const workstealing_victim& v) -> std::size_t {
+            if (topology.same_core(cpu_, v.cpu())) {
+              return 0;
+            }
+            if (topology.same_cache(cpu_, v.cpu())) {
+              return 1;
+            }
+            return v.numa_node() == numa_node_ ? 2 : 3;
+          };
+          std::array<std::vector<workstealing_victim>, n_levels> levels{};
           for (workstealing_victim v: victims) {
             if (v.index() == index_) {
               // skip self
               continue;
             }
-            if (v.numa_node() == numa_node_) {
-              near_victims_.push_back(v);
+            for (std::size_t level = distance(v); level < n_levels; ++level) {
+              levels[level].push_back(v);
+            }
+          }
+          for (std::size_t level = 0; level < n_levels; ++level) {
+            const bool last = level + 1 == n_levels;
+            if (last || (!levels[level].empty() && levels[level].size() < levels[level + 1].size())) {
+              victim_levels_.push_back(std::move(levels[level]));
             }
-            all_victims_.push_back(v);
           }
         }
 
@@ -585,8 +1531,17 @@ namespace exec {
           return numa_node_;
         }
 
+        [[nodiscard]]
+        auto cpu() const noexcept -> int {
+          return cpu_;
+        }
+
         auto as_victim() noexcept -> workstealing_victim {
-          return workstealing_victim{&local_queue_, index_, numa_node_};
+          std::array<local_queue_t*, max_priority + 1> queues{&local_queue_};
+          for (std::uint32_t p = 1; p <= max_priority; ++p) {
+            queues[p] = &priority_lanes_[p - 1].local_queue_;
+          }
+          return workstealing_victim{queues, &next_, &overflow_, index_, numa_node_, cpu_};
         }
 
        private:
@@ -594,39 +1549,116 @@ namespace exec {
           running,
           stealing,
           sleeping,
-          notified
+          notified,
+          retired
         };
 
+        // The queues of a priority above 0. Priority 0 uses local_queue_, overflow_ and the
+        // pool's remote queues. Tasks of a higher priority are pushed to remote_queue_ by other
+        // threads, so that the owner sees them without scanning all remote queues.
+        struct priority_lane {
+          local_queue_t local_queue_;
+          __intrusive_queue<&task_base::next> pending_queue_{};
+          __atomic_intrusive_queue<&task_base::next> remote_queue_{};
+        };
+
+        template <std::size_t... Is>
+        static auto make_priority_lanes(
+          bwos_params params,
+          int numa_node,
+          std::index_sequence<Is...>) -> std::array<priority_lane, sizeof...(Is)> {
+          return {{((void) Is,
+                    priority_lane{local_queue_t(
+                      params.numBlocks, params.blockSize, numa_allocator<task_base*>(numa_node))})...}};
+        }
+
         auto try_pop() -> pop_result;
+        auto try_pop_priority(priority_lane& lane) -> task_base*;
         auto try_remote() -> pop_result;
+        auto try_inject() -> task_base*;
         auto try_steal(std::span<workstealing_victim> victims) -> pop_result;
-        auto try_steal_near() -> pop_result;
-        auto try_steal_any() -> pop_result;
+        auto try_steal_at(std::size_t level) -> pop_result;
+        auto try_steal_next() -> pop_result;
+        auto park(pop_result result) -> pop_result;
+        auto block(pop_result result) -> pop_result;
+        auto wait_or_retire(std::unique_lock<std::mutex>& lock) -> bool;
+        void begin_sleep() noexcept;
+        void end_sleep() noexcept;
 
         void notify_one_sleeping();
         void set_stealing();
-        void clear_stealing();
-
-        bwos::lifo_queue<task_base*, numa_allocator<task_base*>> local_queue_;
-        __intrusive_queue<&task_base::next> pending_queue_{};
+        void clear_stealing(bool found);
+
+        // The task to run next. A worker that schedules onto its own pool puts the task here, so
+        // that it runs right after the current one on the same cpu. The task it displaces goes
+        // to local_queue_.
+        alignas(64) std::atomic<task_base*> next_{nullptr};
+        // Tasks taken from next_ in a row. After max_next_pops of them, try_pop() serves the
+        // other queues first.
+        std::uint32_t nextPops_{0};
+        // Tasks popped since this worker last looked at the injection queue while busy.
+        std::uint32_t injectionTicks_{0};
+        local_queue_t local_queue_;
+        std::array<priority_lane, max_priority> priority_lanes_;
+        // The priority 0 tasks that did not fit into local_queue_. Thieves take from here once
+        // the BWoS queues are empty, so a large fan-out from one worker is not hidden from them.
+        shared_task_queue overflow_{};
         std::mutex mut_{};
         std::condition_variable cv_{};
-        bool stopRequested_{false};
-        std::vector<workstealing_victim> near_victims_{};
-        std::vector<workstealing_victim> all_victims_{};
+        std::atomic<bool> stopRequested_{false};
+        // Set by the worker when it retires, so that pop() returns to run().
+        bool retiring_{false};
+        // When an elastic worker first went to sleep without having run a task since. A wakeup
+        // that brings no task does not restart the idle timeout.
+        std::optional<std::chrono::steady_clock::time_point> idleSince_{};
+        std::vector<std::vector<workstealing_victim>> victim_levels_{};
         std::atomic<state> state_;
         static_thread_pool_* pool_;
         xorshift rng_{};
+        STDEXEC_ATTRIBUTE((no_unique_address))
+        thread_counters<STDEXEC_ENABLE_THREAD_POOL_METRICS != 0> counters_{};
       };
 
       void run(std::uint32_t index, numa_policy* numa) noexcept;
       void join() noexcept;
 
+      [[nodiscard]]
+      auto elastic() const noexcept -> bool {
+        return minThreads_ < threadCount_;
+      }
+
+      // Notifies the worker `index` after work was enqueued to it, and starts it if it retired.
+      void wake(std::size_t index) noexcept;
+      // Wakes a sleeping worker for work in injected_. If every worker is busy in an elastic
+      // pool, starts a retired one.
+      void wake_for_injection() noexcept;
+      void respawn(std::size_t index) noexcept;
+      // Takes a worker off liveThreads_ unless that would leave fewer than minThreads_.
+      auto reserve_retirement() noexcept -> bool;
+      // Returns `index`, or a running worker on an allowed node instead of a retired `index`
+      // while some running worker is idle.
+      auto live_thread_index(std::size_t index, const nodemask& constraints) const noexcept
+        -> std::size_t;
+
       alignas(64) std::atomic<std::uint32_t> numThiefs_{};
+      std::atomic<std::uint32_t> numSleeping_{};
+      std::atomic<std::uint32_t> liveThreads_{};
       alignas(64) remote_queue_list remotes_;
       std::uint32_t threadCount_;
       std::uint32_t maxSteals_{threadCount_ + 1};
       bwos_params params_;
+      idle_params idle_;
+      bulk_params bulk_;
+      // The cpu of every worker, or nothing if the workers are not pinned.
+      std::vector<int> pinnedCpus_;
+      std::string threadNamePrefix_;
+      elastic_params elastic_;
+      std::uint32_t minThreads_;
+      injection_params injection_;
+      alignas(64) shared_task_queue injected_{};
+      // Guards threads_ against a respawn while the pool joins.
+      std::mutex threadsMut_{};
+      bool joining_{false};
       std::vector<std::thread> threads_;
       std::vector<std::optional<thread_state>> threadStates_;
       numa_policy* numa_;
@@ -651,25 +1683,59 @@ namespace exec {
       [[nodiscard]]
       auto get_thread_index(int numa, std::size_t index) const noexcept -> std::size_t;
       auto random_thread_index_with_constraints(const nodemask& contraints) noexcept -> std::size_t;
+
+      // A bulk on a constrained scheduler runs its agents on the threads of the allowed nodes,
+      // agent i on the i-th of them. Constraints without any threads allow all threads.
+      [[nodiscard]]
+      auto bulk_thread_count(const nodemask& constraints) const noexcept -> std::uint32_t;
+      [[nodiscard]]
+      auto bulk_thread_index(const nodemask& constraints, std::uint32_t agent) const noexcept
+        -> std::size_t;
+      // Returns the first node in `constraints` with threads of this pool, or -1 if there is none.
+      [[nodiscard]]
+      auto first_node(const nodemask& constraints) const noexcept -> int;
     };
 
     inline static_thread_pool_::static_thread_pool_()
-      : static_thread_pool_(std::thread::hardware_concurrency()) {
+      : static_thread_pool_(static_thread_pool_params{}) {
     }
 
     inline static_thread_pool_::static_thread_pool_(
       std::uint32_t threadCount,
       bwos_params params,
       numa_policy* numa)
-      : remotes_(threadCount)
-      , threadCount_(threadCount)
-      , params_(params)
-      , threadStates_(threadCount)
-      , numa_{numa} {
-      STDEXEC_ASSERT(threadCount > 0);
-
-      for (std::uint32_t index = 0; index < threadCount; ++index) {
-        threadStates_[index].emplace(this, index, params, numa);
+      : static_thread_pool_([&] {
+        static_thread_pool_params options{};
+        options.threadCount = threadCount;
+        options.bwos = params;
+        options.numa = numa;
+        return options;
+      }()) {
+    }
+
+    inline static_thread_pool_::static_thread_pool_(static_thread_pool_params options)
+      : remotes_(options.threadCount)
+      , threadCount_(options.threadCount)
+      , params_(options.bwos)
+      , idle_(options.idle)
+      , bulk_(options.bulk)
+      , threadNamePrefix_(std::move(options.threads.namePrefix))
+      , elastic_(options.elastic)
+      , minThreads_(std::clamp(options.elastic.minThreads, std::uint32_t{1}, options.threadCount))
+      , injection_(options.injection)
+      , threadStates_(options.threadCount)
+      , numa_{options.numa ? options.numa : get_numa_policy()} {
+      STDEXEC_ASSERT(threadCount_ > 0);
+
+      const thread_params& threads = options.threads;
+      const bool pinsByTopology = threads.pinning == pinning_strategy::scatter
+                               || threads.pinning == pinning_strategy::skip_smt_siblings;
+      cpu_topology topology = pinsByTopology ? cpu_topology::system() : cpu_topology{};
+      pinnedCpus_ = pinned_cpus(threads, threadCount_, topology);
+
+      for (std::uint32_t index = 0; index < threadCount_; ++index) {
+        threadStates_[index].emplace(
+          this, index, params_, numa_, pinnedCpus_.empty() ? -1 : pinnedCpus_[index]);
         threadIndexByNumaNode_.push_back(
           thread_index_by_numa_node{threadStates_[index]->numa_node(), index});
       }
@@ -679,14 +1745,23 @@ namespace exec {
       for (auto& state: threadStates_) {
         victims.emplace_back(state->as_victim());
       }
+      if (!pinsByTopology && threadStates_[0]->cpu() >= 0) {
+        topology = cpu_topology::system();
+      }
       for (auto& state: threadStates_) {
-        state->victims(victims);
+        state->victims(victims, topology);
       }
-      threads_.reserve(threadCount);
+      // Every worker stays a victim while it is retired. Its queues are empty then, so a thief
+      // that picks it finds nothing and moves on.
+      for (std::uint32_t i = minThreads_; i < threadCount_; ++i) {
+        threadStates_[i]->set_retired();
+      }
+      liveThreads_.store(minThreads_, std::memory_order_relaxed);
+      threads_.resize(threadCount_);
 
       try {
-        for (std::uint32_t i = 0; i < threadCount; ++i) {
-          threads_.emplace_back([this, i, numa] { run(i, numa); });
+        for (std::uint32_t i = 0; i < minThreads_; ++i) {
+          threads_[i] = std::thread([this, i] { run(i, numa_); });
         }
       } catch (...) {
         request_stop();
@@ -708,22 +1783,127 @@ namespace exec {
 
     inline void static_thread_pool_::run(std::uint32_t threadIndex, numa_policy* numa) noexcept {
       numa->bind_to_node(threadStates_[threadIndex]->numa_node());
+      this_thread_numa_node = threadStates_[threadIndex]->numa_node();
+      this_thread_pool = this;
+      this_thread_worker_index = threadIndex;
+      if (!pinnedCpus_.empty()) {
+        pin_this_thread(pinnedCpus_[threadIndex]);
+      }
+      if (!threadNamePrefix_.empty()) {
+        name_this_thread(threadNamePrefix_, threadIndex);
+      }
       STDEXEC_ASSERT(threadIndex < threadCount_);
       while (true) {
         // Make a blocking call to de-queue a task if we don't already have one.
         auto [task, queueIndex] = threadStates_[threadIndex]->pop();
         if (!task) {
-          return; // pop() only returns null when request_stop() was called.
+          return; // pop() only returns null after request_stop() or when the worker retires.
         }
+        threadStates_[threadIndex]->counters().on_execute();
         task->__execute(task, queueIndex);
       }
     }
 
     inline void static_thread_pool_::join() noexcept {
-      for (auto& t: threads_) {
-        t.join();
+      std::vector<std::thread> threads{};
+      {
+        std::lock_guard lock{threadsMut_};
+        joining_ = true;
+        threads = std::move(threads_);
+      }
+      for (auto& t: threads) {
+        if (t.joinable()) {
+          t.join();
+        }
+      }
+    }
+
+    inline void static_thread_pool_::wake(std::size_t index) noexcept {
+      if (!threadStates_[index]->notify() && threadStates_[index]->is_retired()) {
+        respawn(index);
+      }
+    }
+
+    // The thread of a retired worker has returned from run() or is about to, so joining it
+    // does not wait long. Starting a thread can throw, which terminates, like any other failure
+    // to enqueue.
+    inline void static_thread_pool_::respawn(std::size_t index) noexcept {
+      if (!threadStates_[index]->try_revive()) {
+        return;
+      }
+      std::lock_guard lock{threadsMut_};
+      if (joining_) {
+        return;
+      }
+      if (threads_[index].joinable()) {
+        threads_[index].join();
+      }
+      threadStates_[index]->clear_retiring();
+      liveThreads_.fetch_add(1, std::memory_order_relaxed);
+      const auto i = static_cast<std::uint32_t>(index);
+      threads_[index] = std::thread([this, i] { run(i, numa_); });
+    }
+
+    // A worker counts itself in numSleeping_ before it looks at the queues for the last time.
+    // With the fence here and the one in thread_state::begin_sleep(), either that worker sees
+    // the injected task or this sees the worker, so workers are only scanned while some sleep.
+    // Thieves look at the injection queue before they sleep.
+    inline void static_thread_pool_::wake_for_injection() noexcept {
+      thread_local std::uint32_t startIndex{std::uint32_t(std::random_device{}())};
+      startIndex += 1;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (numSleeping_.load(std::memory_order_relaxed) != 0) {
+        for (std::uint32_t i = 0; i < threadCount_; ++i) {
+          if (threadStates_[(startIndex + i) % threadCount_]->notify()) {
+            return;
+          }
+        }
+      }
+      if (
+        !elastic()
+        || numThiefs_.load(std::memory_order_relaxed) + numSleeping_.load(std::memory_order_relaxed)
+             != 0) {
+        return;
+      }
+      for (std::uint32_t i = 0; i < threadCount_; ++i) {
+        const std::uint32_t index = (startIndex + i) % threadCount_;
+        if (threadStates_[index]->is_retired()) {
+          respawn(index);
+          return;
+        }
+      }
+    }
+
+    inline auto static_thread_pool_::reserve_retirement() noexcept -> bool {
+      std::uint32_t live = liveThreads_.load(std::memory_order_relaxed);
+      while (live > minThreads_) {
+        if (liveThreads_.compare_exchange_weak(live, live - 1, std::memory_order_relaxed)) {
+          return true;
+        }
       }
-      threads_.clear();
+      return false;
+    }
+
+    inline auto static_thread_pool_::live_thread_index(
+      std::size_t index,
+      const nodemask& constraints) const noexcept -> std::size_t {
+      if (!threadStates_[index]->is_retired()) {
+        return index;
+      }
+      // With every running worker busy, the work backs up. Let it start the retired worker.
+      if (
+        numThiefs_.load(std::memory_order_relaxed) + numSleeping_.load(std::memory_order_relaxed)
+        == 0) {
+        return index;
+      }
+      for (std::size_t i = 1; i < threadCount_; ++i) {
+        const std::size_t other = (index + i) % threadCount_;
+        const thread_state& state = *threadStates_[other];
+        if (!state.is_retired() && constraints[static_cast<std::size_t>(state.numa_node())]) {
+          return other;
+        }
+      }
+      return index;
     }
 
     inline void
@@ -765,6 +1945,46 @@ namespace exec {
       return it->thread_index;
     }
 
+    inline auto static_thread_pool_::bulk_thread_count(const nodemask& constraints) const noexcept
+      -> std::uint32_t {
+      if (constraints == nodemask::any()) {
+        return threadCount_;
+      }
+      const std::size_t nThreads = num_threads(constraints);
+      return nThreads == 0 ? threadCount_ : static_cast<std::uint32_t>(nThreads);
+    }
+
+    inline auto static_thread_pool_::bulk_thread_index(
+      const nodemask& constraints,
+      std::uint32_t agent) const noexcept -> std::size_t {
+      if (constraints == nodemask::any()) {
+        return agent;
+      }
+      const std::size_t nNodes = static_cast<unsigned>(threadIndexByNumaNode_.back().numa_node + 1);
+      std::size_t targetIndex = agent;
+      for (std::size_t nodeIndex = 0; nodeIndex < nNodes; ++nodeIndex) {
+        if (!constraints[nodeIndex]) {
+          continue;
+        }
+        const std::size_t nThreads = num_threads(static_cast<int>(nodeIndex));
+        if (targetIndex < nThreads) {
+          return get_thread_index(static_cast<int>(nodeIndex), targetIndex);
+        }
+        targetIndex -= nThreads;
+      }
+      return agent;
+    }
+
+    inline auto static_thread_pool_::first_node(const nodemask& constraints) const noexcept -> int {
+      const std::size_t nNodes = static_cast<unsigned>(threadIndexByNumaNode_.back().numa_node + 1);
+      for (std::size_t nodeIndex = 0; nodeIndex < nNodes; ++nodeIndex) {
+        if (constraints[nodeIndex] && num_threads(static_cast<int>(nodeIndex)) != 0) {
+          return static_cast<int>(nodeIndex);
+        }
+      }
+      return -1;
+    }
+
     inline auto static_thread_pool_::random_thread_index_with_constraints(
       const nodemask& constraints) noexcept -> std::size_t {
       thread_local std::uint64_t startIndex{std::uint64_t(std::random_device{}())};
@@ -772,7 +1992,10 @@ namespace exec {
       std::size_t targetIndex = startIndex % threadCount_;
       std::size_t nThreads = num_threads(constraints);
       if (nThreads != 0) {
-        for (std::size_t nodeIndex = 0; nodeIndex < numa_->num_nodes(); ++nodeIndex) {
+        // Node ids need not be contiguous, so num_nodes() is no bound for them.
+        const std::size_t nNodes =
+          static_cast<unsigned>(threadIndexByNumaNode_.back().numa_node + 1);
+        for (std::size_t nodeIndex = 0; nodeIndex < nNodes; ++nodeIndex) {
           if (!constraints[nodeIndex]) {
             continue;
           }
@@ -789,39 +2012,88 @@ namespace exec {
     inline void static_thread_pool_::enqueue(
       remote_queue& queue,
       task_base* task,
-      const nodemask& constraints) noexcept {
-      static thread_local std::thread::id this_id = std::this_thread::get_id();
-      remote_queue* correct_queue = this_id == queue.id_ ? &queue : get_remote_queue();
-      std::size_t idx = correct_queue->index_;
-      if (idx < threadStates_.size()) {
+      const nodemask& constraints,
+      std::uint32_t priority) noexcept {
+      if (this_thread_pool == this) {
+        const std::uint32_t idx = this_thread_worker_index;
         auto this_node = static_cast<std::size_t>(threadStates_[idx]->numa_node());
         if (constraints[this_node]) {
-          threadStates_[idx]->push_local(task);
+          if (priority == 0) {
+            threadStates_[idx]->push_next(task);
+          } else {
+            threadStates_[idx]->push_local(task, priority);
+          }
           return;
         }
       }
 
-      const std::size_t threadIndex = random_thread_index_with_constraints(constraints);
-      queue.queues_[threadIndex].push_front(task);
-      threadStates_[threadIndex]->notify();
+      if (injection_.enabled && priority == 0 && constraints == nodemask::any()) {
+        injected_.push(task);
+        wake_for_injection();
+        return;
+      }
+
+      std::size_t threadIndex = random_thread_index_with_constraints(constraints);
+      if (elastic()) {
+        threadIndex = live_thread_index(threadIndex, constraints);
+      }
+      threadStates_[threadIndex]->counters().on_remote_enqueue(1);
+      if (priority == 0) {
+        queue.push_front(threadIndex, task);
+      } else {
+        threadStates_[threadIndex]->push_remote(task, priority);
+      }
+      wake(threadIndex);
     }
 
     inline void static_thread_pool_::enqueue(
       remote_queue& queue,
       task_base* task,
-      std::size_t threadIndex) noexcept {
+      std::size_t threadIndex,
+      std::uint32_t priority) noexcept {
       threadIndex %= threadCount_;
-      queue.queues_[threadIndex].push_front(task);
-      threadStates_[threadIndex]->notify();
+      threadStates_[threadIndex]->counters().on_remote_enqueue(1);
+      if (priority == 0) {
+        queue.push_front(threadIndex, task);
+      } else {
+        threadStates_[threadIndex]->push_remote(task, priority);
+      }
+      wake(threadIndex);
+    }
+
+    // Returns the range `[first, last)` of the children of bulk task `index` out of `n_threads`.
+    inline auto bulk_tree_children(std::uint32_t index, std::uint32_t n_threads) noexcept
+      -> std::pair<std::uint32_t, std::uint32_t> {
+      const std::uint64_t first = std::uint64_t{static_thread_pool_::bulk_fan_out} * index + 1;
+      const std::uint64_t last = first + static_thread_pool_::bulk_fan_out;
+      return {
+        static_cast<std::uint32_t>(std::min<std::uint64_t>(first, n_threads)),
+        static_cast<std::uint32_t>(std::min<std::uint64_t>(last, n_threads))};
     }
 
     template <std::derived_from<task_base> TaskT>
-    void static_thread_pool_::bulk_enqueue(TaskT* task, std::uint32_t n_threads) noexcept {
-      auto& queue = *get_remote_queue();
-      for (std::size_t i = 0; i < n_threads; ++i) {
-        std::uint32_t index = i % available_parallelism();
-        queue.queues_[index].push_front(task + i);
-        threadStates_[index]->notify();
+    void static_thread_pool_::bulk_enqueue(
+      TaskT* task,
+      std::uint32_t n_threads,
+      const nodemask& constraints) noexcept {
+      if (n_threads != 0) {
+        const std::size_t threadIndex = bulk_thread_index(constraints, 0);
+        threadStates_[threadIndex]->push_stealable(task);
+        wake(threadIndex);
+      }
+    }
+
+    template <std::derived_from<task_base> TaskT>
+    void static_thread_pool_::bulk_enqueue_children(
+      TaskT* tasks,
+      std::uint32_t index,
+      std::uint32_t n_threads,
+      const nodemask& constraints) noexcept {
+      auto [first, last] = bulk_tree_children(index, n_threads);
+      for (std::uint32_t child = first; child < last; ++child) {
+        const std::size_t threadIndex = bulk_thread_index(constraints, child);
+        threadStates_[threadIndex]->push_stealable(tasks + child);
+        wake(threadIndex);
       }
     }
 
@@ -830,10 +2102,8 @@ namespace exec {
       __intrusive_queue<&task_base::next> tasks,
       std::size_t tasks_size,
       const nodemask& constraints) noexcept {
-      static thread_local std::thread::id this_id = std::this_thread::get_id();
-      remote_queue* correct_queue = this_id == queue.id_ ? &queue : get_remote_queue();
-      std::size_t idx = correct_queue->index_;
-      if (idx < threadStates_.size()) {
+      if (this_thread_pool == this) {
+        const std::uint32_t idx = this_thread_worker_index;
         auto this_node = static_cast<std::size_t>(threadStates_[idx]->numa_node());
         if (constraints[this_node]) {
           threadStates_[idx]->push_local(std::move(tasks));
@@ -841,19 +2111,32 @@ namespace exec {
         }
       }
 
-      std::size_t nThreads = available_parallelism();
-      for (std::size_t i = 0; i < nThreads; ++i) {
-        auto [i0, iEnd] =
-          even_share(tasks_size, static_cast<std::uint32_t>(i), available_parallelism());
-        if (i0 == iEnd) {
+      // The tasks are split between the running workers only, so that the batch does not start
+      // every retired worker of an elastic pool. A worker that retires meanwhile is skipped as
+      // well, except for the last one, which takes whatever is left and is started by wake().
+      std::uint32_t nTargets = 0;
+      for (std::uint32_t i = 0; i < threadCount_; ++i) {
+        nTargets += threadStates_[i]->is_retired() ? 0 : 1;
+      }
+      nTargets = std::max(nTargets, std::uint32_t{1});
+      std::uint32_t rank = 0;
+      for (std::uint32_t i = 0; i < threadCount_ && !tasks.empty(); ++i) {
+        const bool last = rank + 1 == nTargets || i + 1 == threadCount_;
+        if (!last && threadStates_[i]->is_retired()) {
           continue;
         }
+        auto [i0, iEnd] = even_share(tasks_size, rank++, nTargets);
         __intrusive_queue<&task_base::next> tmp{};
-        for (std::size_t j = i0; j < iEnd; ++j) {
+        std::size_t n = 0;
+        for (std::size_t j = i0; (last || j < iEnd) && !tasks.empty(); ++j, ++n) {
           tmp.push_back(tasks.pop_front());
         }
-        correct_queue->queues_[i].prepend(std::move(tmp));
-        threadStates_[i]->notify();
+        if (n == 0) {
+          continue;
+        }
+        threadStates_[i]->counters().on_remote_enqueue(n);
+        queue.prepend(i, std::move(tmp));
+        wake(i);
       }
     }
 
@@ -870,23 +2153,103 @@ namespace exec {
       -> static_thread_pool_::thread_state::pop_result {
       pop_result result{nullptr, index_};
       __intrusive_queue<&task_base::next> remotes = pool_->remotes_.pop_all_reversed(index_);
-      pending_queue_.append(std::move(remotes));
-      if (!pending_queue_.empty()) {
-        move_pending_to_local(pending_queue_, local_queue_);
+      counters_.on_remote_dequeue(remotes);
+      // The overflow is older than the remote tasks, so it goes first.
+      __intrusive_queue<&task_base::next> tasks =
+        overflow_.pop(1, local_queue_.get_free_capacity());
+      tasks.append(std::move(remotes));
+      if (!tasks.empty()) {
+        push_local(std::move(tasks));
         result.task = local_queue_.pop_back();
+        if (result.task) {
+          counters_.on_remote_pop();
+        }
+      }
+      if (!result.task && pool_->injection_.enabled) {
+        result.task = try_inject();
       }
 
       return result;
     }
 
+    // Runs the first task of this worker's share of the injection queue and keeps the rest in
+    // the local queue, where other workers can steal them.
+    inline auto static_thread_pool_::thread_state::try_inject() -> task_base* {
+      const bwos_params& params = pool_->params_;
+      __intrusive_queue<&task_base::next> tasks =
+        pool_->injected_.pop(pool_->threadCount_, params.numBlocks * params.blockSize / 2);
+      if (tasks.empty()) {
+        return nullptr;
+      }
+      task_base* task = tasks.pop_front();
+      push_local(std::move(tasks));
+      counters_.on_remote_pop();
+      return task;
+    }
+
+    inline auto static_thread_pool_::thread_state::try_pop_priority(priority_lane& lane)
+      -> task_base* {
+      task_base* task = lane.local_queue_.pop_back();
+      if (task) {
+        counters_.on_local_pop();
+        return task;
+      }
+      if (!lane.remote_queue_.empty()) {
+        __intrusive_queue<&task_base::next> remotes = lane.remote_queue_.pop_all_reversed();
+        counters_.on_remote_dequeue(remotes);
+        lane.pending_queue_.append(std::move(remotes));
+      }
+      if (!lane.pending_queue_.empty()) {
+        move_pending_to_local(lane.pending_queue_, lane.local_queue_);
+        task = lane.local_queue_.pop_back();
+        if (task) {
+          counters_.on_remote_pop();
+        }
+      }
+      return task;
+    }
+
     inline auto static_thread_pool_::thread_state::try_pop()
       -> static_thread_pool_::thread_state::pop_result {
       pop_result result{nullptr, index_};
+      for (std::size_t p = priority_lanes_.size(); p > 0; --p) {
+        result.task = try_pop_priority(priority_lanes_[p - 1]);
+        if (result.task) {
+          return result;
+        }
+      }
+      if (
+        pool_->injection_.enabled
+        && ++injectionTicks_ >= std::max(pool_->injection_.fairnessInterval, std::uint32_t{1})) {
+        injectionTicks_ = 0;
+        result.task = try_inject();
+        if (result.task) {
+          return result;
+        }
+      }
+      if (nextPops_ < max_next_pops) {
+        result.task = next_.exchange(nullptr, std::memory_order_acquire);
+        if (result.task) {
+          ++nextPops_;
+          counters_.on_local_pop();
+          return result;
+        }
+      }
+      nextPops_ = 0;
       result.task = local_queue_.pop_back();
       if (result.task) [[likely]] {
+        counters_.on_local_pop();
         return result;
       }
-      return try_remote();
+      result = try_remote();
+      if (!result.task) {
+        // next_ may have been skipped above.
+        result.task = next_.exchange(nullptr, std::memory_order_acquire);
+        if (result.task) {
+          counters_.on_local_pop();
+        }
+      }
+      return result;
     }
 
     inline auto static_thread_pool_::thread_state::try_steal(std::span<workstealing_victim> victims)
@@ -898,36 +2261,96 @@ namespace exec {
         0, static_cast<std::uint32_t>(victims.size() - 1));
       std::uint32_t victimIndex = dist(rng_);
       auto& v = victims[victimIndex];
-      return {v.try_steal(), v.index()};
+      if (task_base* task = v.try_steal()) {
+        return {task, v.index()};
+      }
+      // Take a batch of the overflow, so that the next steals from it are local pops.
+      __intrusive_queue<&task_base::next> tasks =
+        v.try_steal_overflow(local_queue_.get_free_capacity() + 1);
+      if (tasks.empty()) {
+        return {nullptr, v.index()};
+      }
+      task_base* task = tasks.pop_front();
+      push_local(std::move(tasks));
+      return {task, v.index()};
     }
 
-    inline auto static_thread_pool_::thread_state::try_steal_near()
+    inline auto static_thread_pool_::thread_state::try_steal_next()
       -> static_thread_pool_::thread_state::pop_result {
-      return try_steal(near_victims_);
+      const std::vector<workstealing_victim>& victims = victim_levels_.back();
+      if (victims.empty()) {
+        return {nullptr, index_};
+      }
+      std::uniform_int_distribution<std::size_t> dist(0, victims.size() - 1);
+      const std::size_t start = dist(rng_);
+      for (std::size_t i = 0; i < victims.size(); ++i) {
+        workstealing_victim v = victims[(start + i) % victims.size()];
+        if (task_base* task = v.try_steal_next()) {
+          counters_.on_steal(false, true);
+          return {task, v.index()};
+        }
+      }
+      return {nullptr, index_};
     }
 
-    inline auto static_thread_pool_::thread_state::try_steal_any()
+    inline auto static_thread_pool_::thread_state::try_steal_at(std::size_t level)
       -> static_thread_pool_::thread_state::pop_result {
-      return try_steal(all_victims_);
+      pop_result result = try_steal(victim_levels_[level]);
+      counters_.on_steal(level + 1 < victim_levels_.size(), result.task != nullptr);
+      return result;
     }
 
-    inline void static_thread_pool_::thread_state::push_local(task_base* task) {
-      if (!local_queue_.push_back(task)) {
-        pending_queue_.push_back(task);
+    inline void
+      static_thread_pool_::thread_state::push_local(task_base* task, std::uint32_t priority) {
+      if (priority == 0) {
+        if (!local_queue_.push_back(task)) {
+          overflow_.push(task);
+        }
+        return;
+      }
+      priority_lane& lane = priority_lanes_[priority - 1];
+      if (!lane.local_queue_.push_back(task)) {
+        lane.pending_queue_.push_back(task);
+      }
+    }
+
+    inline void static_thread_pool_::thread_state::push_next(task_base* task) {
+      if (task_base* displaced = next_.exchange(task, std::memory_order_acq_rel)) {
+        push_local(displaced);
       }
     }
 
+    inline void static_thread_pool_::thread_state::push_remote(
+      task_base* task,
+      std::uint32_t priority) noexcept {
+      priority_lanes_[priority - 1].remote_queue_.push_front(task);
+    }
+
+    // Unlike the remote queue, the overflow can be pushed to from any thread and stolen from.
+    inline void static_thread_pool_::thread_state::push_stealable(task_base* task) noexcept {
+      overflow_.push(task);
+    }
+
     inline void
       static_thread_pool_::thread_state::push_local(__intrusive_queue<&task_base::next>&& tasks) {
-      pending_queue_.prepend(std::move(tasks));
+      if (tasks.empty()) {
+        return;
+      }
+      auto last = local_queue_.push_back(tasks.begin(), tasks.end());
+      __intrusive_queue<&task_base::next> pushed{};
+      pushed.splice(pushed.begin(), tasks, tasks.begin(), last);
+      pushed.clear();
+      overflow_.prepend(std::move(tasks));
     }
 
     inline void static_thread_pool_::thread_state::set_stealing() {
       pool_->numThiefs_.fetch_add(1, std::memory_order_relaxed);
     }
 
-    inline void static_thread_pool_::thread_state::clear_stealing() {
-      if (pool_->numThiefs_.fetch_sub(1, std::memory_order_relaxed) == 1) {
+    // The last thief to find a task wakes another worker, which steals in its place. A thief
+    // that found nothing wakes nobody. Otherwise idle workers would keep waking each other.
+    inline void static_thread_pool_::thread_state::clear_stealing(bool found) {
+      if (pool_->numThiefs_.fetch_sub(1, std::memory_order_relaxed) == 1 && found) {
         notify_one_sleeping();
       }
     }
@@ -948,61 +2371,172 @@ namespace exec {
 
     inline auto
       static_thread_pool_::thread_state::pop() -> static_thread_pool_::thread_state::pop_result {
+      idleSince_.reset();
       pop_result result = try_pop();
       while (!result.task) {
         set_stealing();
-        for (std::size_t i = 0; i < pool_->maxSteals_; ++i) {
-          result = try_steal_near();
-          if (result.task) {
-            clear_stealing();
-            return result;
+        for (std::size_t level = 0; level < victim_levels_.size(); ++level) {
+          for (std::size_t i = 0; i < pool_->maxSteals_; ++i) {
+            result = try_steal_at(level);
+            if (result.task) {
+              clear_stealing(true);
+              return result;
+            }
           }
         }
-
-        for (std::size_t i = 0; i < pool_->maxSteals_; ++i) {
-          result = try_steal_any();
-          if (result.task) {
-            clear_stealing();
-            return result;
-          }
+        result = try_steal_next();
+        if (result.task) {
+          clear_stealing(true);
+          return result;
         }
-        std::this_thread::yield();
-        clear_stealing();
+        if (pool_->idle_.strategy == idle_strategy::spin_then_park) {
+          clear_stealing(false);
+          result = park(result);
+        } else {
+          std::this_thread::yield();
+          clear_stealing(false);
+          result = block(result);
+        }
+        if (!result.task && (retiring_ || stopRequested_.load(std::memory_order_acquire))) {
+          return result;
+        }
+      }
+      return result;
+    }
 
-        std::unique_lock lock{mut_};
-        if (stopRequested_) {
+    inline auto static_thread_pool_::thread_state::block(pop_result result)
+      -> static_thread_pool_::thread_state::pop_result {
+      std::unique_lock lock{mut_};
+      if (stopRequested_.load(std::memory_order_relaxed)) {
+        return result;
+      }
+      state expected = state::running;
+      if (state_.compare_exchange_weak(expected, state::sleeping, std::memory_order_relaxed)) {
+        begin_sleep();
+        result = try_remote();
+        if (result.task) {
+          end_sleep();
+          return result;
+        }
+        auto sleepStart = counters_.sleep_begin();
+        const bool retired = wait_or_retire(lock);
+        end_sleep();
+        counters_.sleep_end(sleepStart, state_.load(std::memory_order_relaxed) == state::notified);
+        if (retired) {
           return result;
         }
-        state expected = state::running;
-        if (state_.compare_exchange_weak(expected, state::sleeping, std::memory_order_relaxed)) {
-          result = try_remote();
-          if (result.task) {
-            return result;
+      }
+      lock.unlock();
+      state_.store(state::running, std::memory_order_relaxed);
+      return try_pop();
+    }
+
+    // Every remote enqueue is followed by a notify() of the target thread, which sets state_ to
+    // notified. Spinning on state_ therefore catches new work without touching the queues. When
+    // the spin runs out, the thread parks on state_ itself. Since notify() changes state_ before
+    // it wakes the thread, std::atomic::wait cannot miss it.
+    inline auto static_thread_pool_::thread_state::park(pop_result result)
+      -> static_thread_pool_::thread_state::pop_result {
+      for (std::uint32_t i = 0; i < pool_->idle_.spinCount; ++i) {
+        if (state_.load(std::memory_order_relaxed) == state::notified) {
+          state_.store(state::running, std::memory_order_relaxed);
+          return try_pop();
+        }
+        stdexec::__spin_loop_pause();
+      }
+      state expected = state::running;
+      if (state_.compare_exchange_strong(expected, state::sleeping, std::memory_order_relaxed)) {
+        begin_sleep();
+        result = try_remote();
+        if (!result.task) {
+          auto sleepStart = counters_.sleep_begin();
+          if (pool_->elastic()) {
+            // std::atomic::wait has no timeout, so an elastic pool sleeps on cv_ instead.
+            std::unique_lock lock{mut_};
+            if (wait_or_retire(lock)) {
+              end_sleep();
+              return result;
+            }
+          } else {
+            state_.wait(state::sleeping, std::memory_order_relaxed);
           }
-          cv_.wait(lock);
+          counters_.sleep_end(sleepStart, state_.load(std::memory_order_relaxed) == state::notified);
         }
-        lock.unlock();
-        state_.store(state::running, std::memory_order_relaxed);
-        result = try_pop();
+        end_sleep();
       }
-      return result;
+      state_.store(state::running, std::memory_order_relaxed);
+      return result.task ? result : try_pop();
+    }
+
+    // Waits on cv_ with `lock` held and state_ sleeping. In an elastic pool the worker retires
+    // if it has found no task for the idle timeout and enough workers remain. A notify() that
+    // comes later finds the worker retired and starts it again. Returns true if it retired.
+    inline auto static_thread_pool_::thread_state::wait_or_retire(std::unique_lock<std::mutex>& lock)
+      -> bool {
+      if (!pool_->elastic()) {
+        cv_.wait(lock);
+        return false;
+      }
+      if (!idleSince_) {
+        idleSince_ = std::chrono::steady_clock::now();
+      }
+      const bool woken = cv_.wait_until(lock, *idleSince_ + pool_->elastic_.idleTimeout, [this] {
+        return state_.load(std::memory_order_relaxed) != state::sleeping
+            || stopRequested_.load(std::memory_order_relaxed);
+      });
+      if (woken || !pool_->reserve_retirement()) {
+        return false;
+      }
+      state expected = state::sleeping;
+      if (state_.compare_exchange_strong(expected, state::retired, std::memory_order_relaxed)) {
+        retiring_ = true;
+        return true;
+      }
+      pool_->liveThreads_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    inline void static_thread_pool_::thread_state::begin_sleep() noexcept {
+      pool_->numSleeping_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    inline void static_thread_pool_::thread_state::end_sleep() noexcept {
+      pool_->numSleeping_.fetch_sub(1, std::memory_order_relaxed);
     }
 
+    // A retired worker stays retired, so that notify_one_sleeping() does not start it.
     inline auto static_thread_pool_::thread_state::notify() -> bool {
-      if (state_.exchange(state::notified, std::memory_order_relaxed) == state::sleeping) {
-        {
-          std::lock_guard lock{mut_};
+      state previous = state_.load(std::memory_order_relaxed);
+      do {
+        if (previous == state::retired) {
+          return false;
+        }
+      } while (!state_.compare_exchange_weak(previous, state::notified, std::memory_order_relaxed));
+      if (previous == state::sleeping) {
+        if (pool_->idle_.strategy == idle_strategy::spin_then_park && !pool_->elastic()) {
+          state_.notify_one();
+        } else {
+          {
+            std::lock_guard lock{mut_};
+          }
+          cv_.notify_one();
         }
-        cv_.notify_one();
         return true;
       }
       return false;
     }
 
     inline void static_thread_pool_::thread_state::request_stop() {
+      if (pool_->idle_.strategy == idle_strategy::spin_then_park && !pool_->elastic()) {
+        stopRequested_.store(true, std::memory_order_release);
+        state_.store(state::notified, std::memory_order_release);
+        state_.notify_one();
+        return;
+      }
       {
         std::lock_guard lock{mut_};
-        stopRequested_ = true;
+        stopRequested_.store(true, std::memory_order_relaxed);
       }
       cv_.notify_one();
     }
@@ -1017,18 +2551,24 @@ namespace exec {
       Receiver rcvr_;
       std::size_t threadIndex_{};
       nodemask constraints_{};
+      std::uint32_t priority_{0};
+      submission_batch* batch_{nullptr};
 
       explicit __t(
         static_thread_pool_& pool,
         remote_queue* queue,
         Receiver rcvr,
         std::size_t tid,
-        const nodemask& constraints)
+        const nodemask& constraints,
+        std::uint32_t priority,
+        submission_batch* batch)
         : pool_(pool)
         , queue_(queue)
         , rcvr_(static_cast<Receiver&&>(rcvr))
         , threadIndex_{tid}
-        , constraints_{constraints} {
+        , constraints_{constraints}
+        , priority_{priority}
+        , batch_{batch} {
         this->__execute = [](task_base* t, const std::uint32_t /* tid */) noexcept {
           auto& op = *static_cast<__t*>(t);
           auto stoken = get_stop_token(get_env(op.rcvr_));
@@ -1045,11 +2585,14 @@ namespace exec {
       }
 
       void enqueue_(task_base* op) const {
+        if (batch_ != nullptr && batch_->push(op)) {
+          return;
+        }
         if (threadIndex_ < pool_.available_parallelism()) {
-          pool_.enqueue(*queue_, op, threadIndex_);
+          pool_.enqueue(*queue_, op, threadIndex_, priority_);
         } else {
 
-          pool_.enqueue(*queue_, op, constraints_);
+          pool_.enqueue(*queue_, op, constraints_, priority_);
         }
       }
 
@@ -1069,6 +2612,7 @@ namespace exec {
       Sender sndr_;
       Shape shape_;
       Fun fun_;
+      nodemask constraints_{nodemask::any()};
 
       template <class Sender, class Env>
       using with_error_invoke_t = //
@@ -1102,13 +2646,15 @@ namespace exec {
                  Shape,
                  Fun,
                  Sender,
-                 Receiver>) -> bulk_op_state_t<Self, Receiver> {
+                 Receiver,
+                 const nodemask&>) -> bulk_op_state_t<Self, Receiver> {
         return bulk_op_state_t<Self, Receiver>{
           self.pool_,
           self.shape_,
           self.fun_,
           static_cast<Self&&>(self).sndr_,
-          static_cast<Receiver&&>(rcvr)};
+          static_cast<Receiver&&>(rcvr),
+          self.constraints_};
       }
 
       template <__decays_to<__t> Self, class Env>
@@ -1121,21 +2667,56 @@ namespace exec {
       }
     };
 
+    // Returns the allocator of the receiver's environment, or std::allocator if it has none.
+    template <class Receiver>
+    auto receiver_allocator(const Receiver& rcvr) noexcept {
+      if constexpr (__callable<get_allocator_t, env_of_t<Receiver>>) {
+        return stdexec::get_allocator(stdexec::get_env(rcvr));
+      } else {
+        return std::allocator<char>{};
+      }
+    }
+
+    template <class Receiver, class Ty>
+    using receiver_allocator_t = typename std::allocator_traits<
+      decltype(receiver_allocator(__declval<const Receiver&>()))>::template rebind_alloc<Ty>;
+
     template <class CvrefSender, class Receiver, class Shape, class Fun, bool MayThrow>
     struct static_thread_pool_::bulk_shared_state {
       struct bulk_task : task_base {
         bulk_shared_state* sh_state_;
-
-        bulk_task(bulk_shared_state* sh_state)
-          : sh_state_(sh_state) {
-          this->__execute = [](task_base* t, const std::uint32_t tid) noexcept {
-            auto& sh_state = *static_cast<bulk_task*>(t)->sh_state_;
+        // This task and its children in the fan-out tree that have not finished yet.
+        std::atomic<std::uint32_t> pending_;
+
+        bulk_task(bulk_shared_state* sh_state, std::uint32_t pending)
+          : sh_state_(sh_state)
+          , pending_(pending) {
+          this->__execute = [](task_base* t, const std::uint32_t /* tid */) noexcept {
+            auto* self = static_cast<bulk_task*>(t);
+            auto& sh_state = *self->sh_state_;
             auto total_threads = sh_state.num_agents_required();
+            // A stolen task runs on another thread than the one it was enqueued to, so the
+            // agent is identified by its task rather than by `tid`.
+            const auto agent = static_cast<std::uint32_t>(self - sh_state.tasks_);
+            sh_state.pool_.bulk_enqueue_children(
+              sh_state.tasks_, agent, total_threads, sh_state.constraints_);
 
             auto computation = [&](auto&... args) {
-              auto [begin, end] = even_share(sh_state.shape_, tid, total_threads);
-              for (Shape i = begin; i < end; ++i) {
-                sh_state.fun_(i, args...);
+              if (sh_state.strategy_ == bulk_strategy::static_split) {
+                auto [begin, end] = even_share(sh_state.shape_, agent, total_threads);
+                for (Shape i = begin; i < end; ++i) {
+                  sh_state.fun_(i, args...);
+                }
+                return;
+              }
+              // A task that starts late, e.g. because its thread was busy, finds the counter
+              // exhausted and only reports that it finished.
+              Shape begin{};
+              Shape end{};
+              while (sh_state.claim_chunk(begin, end)) {
+                for (Shape i = begin; i < end; ++i) {
+                  sh_state.fun_(i, args...);
+                }
               }
             };
 
@@ -1150,15 +2731,14 @@ namespace exec {
                 std::uint32_t expected = total_threads;
 
                 if (sh_state.thread_with_exception_.compare_exchange_strong(
-                      expected, tid, std::memory_order_relaxed, std::memory_order_relaxed)) {
+                      expected, agent, std::memory_order_relaxed, std::memory_order_relaxed)) {
                   sh_state.exception_ = std::current_exception();
                 }
+                // Keep the other tasks from claiming more work.
+                sh_state.next_.store(sh_state.shape_, std::memory_order_relaxed);
               }
 
-              const bool is_last_thread = sh_state.finished_threads_.fetch_add(1)
-                                       == (total_threads - 1);
-
-              if (is_last_thread) {
+              if (sh_state.arrive(self)) {
                 if (sh_state.exception_) {
                   set_error(static_cast<Receiver&&>(sh_state.rcvr_), std::move(sh_state.exception_));
                 } else {
@@ -1168,10 +2748,7 @@ namespace exec {
             } else {
               sh_state.apply(computation);
 
-              const bool is_last_thread = sh_state.finished_threads_.fetch_add(1)
-                                       == (total_threads - 1);
-
-              if (is_last_thread) {
+              if (sh_state.arrive(self)) {
                 sh_state.apply(completion);
               }
             }
@@ -1187,16 +2764,63 @@ namespace exec {
       Receiver rcvr_;
       Shape shape_;
       Fun fun_;
+      nodemask constraints_;
+      std::uint32_t n_agents_;
+
+      bulk_strategy strategy_;
+      Shape grain_;
+      std::atomic<Shape> next_{0};
 
-      std::atomic<std::uint32_t> finished_threads_{0};
       std::atomic<std::uint32_t> thread_with_exception_{0};
       std::exception_ptr exception_;
-      std::vector<bulk_task> tasks_;
+
+      // Pools with up to this many threads keep the bulk tasks in the operation state. Larger
+      // ones allocate them with the receiver's allocator.
+      static constexpr std::uint32_t inline_task_count = 16;
+      using task_allocator_t = receiver_allocator_t<Receiver, bulk_task>;
+
+      // Taken from the receiver before it completes, which may move from `rcvr_`.
+      STDEXEC_ATTRIBUTE((no_unique_address)) task_allocator_t task_alloc_;
+      alignas(bulk_task) unsigned char inline_tasks_[inline_task_count * sizeof(bulk_task)];
+      bulk_task* tasks_;
 
       [[nodiscard]]
       auto num_agents_required() const -> std::uint32_t {
-        return static_cast<std::uint32_t>(
-          std::min(shape_, static_cast<Shape>(pool_.available_parallelism())));
+        return n_agents_;
+      }
+
+      // Marks `task` as finished and propagates up the fan-out tree every node whose subtree is
+      // now complete. Returns true in the one task that completes the root.
+      auto arrive(bulk_task* task) noexcept -> bool {
+        while (task->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          const auto index = static_cast<std::uint32_t>(task - tasks_);
+          if (index == 0) {
+            return true;
+          }
+          task = tasks_ + (index - 1) / bulk_fan_out;
+        }
+        return false;
+      }
+
+      // Claims the next chunk `[begin, end)` for the dynamic and guided strategies. Returns
+      // false once all indices have been handed out.
+      auto claim_chunk(Shape& begin, Shape& end) noexcept -> bool {
+        Shape current = next_.load(std::memory_order_relaxed);
+        while (current < shape_) {
+          const Shape remaining = shape_ - current;
+          Shape chunk = grain_;
+          if (strategy_ == bulk_strategy::guided) {
+            chunk = std::max(chunk, static_cast<Shape>(remaining / (2 * num_agents_required())));
+          }
+          chunk = std::min(chunk, remaining);
+          if (next_.compare_exchange_weak(
+                current, current + chunk, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            begin = current;
+            end = current + chunk;
+            return true;
+          }
+        }
+        return false;
       }
 
       template <class F>
@@ -1206,13 +2830,47 @@ namespace exec {
           data_);
       }
 
-      bulk_shared_state(static_thread_pool_& pool, Receiver rcvr, Shape shape, Fun fun)
+      bulk_shared_state(
+        static_thread_pool_& pool,
+        Receiver rcvr,
+        Shape shape,
+        Fun fun,
+        const nodemask& constraints)
         : pool_{pool}
         , rcvr_{static_cast<Receiver&&>(rcvr)}
         , shape_{shape}
         , fun_{fun}
+        , constraints_{constraints}
+        , n_agents_{static_cast<std::uint32_t>(
+            std::min(shape, static_cast<Shape>(pool.bulk_thread_count(constraints))))}
+        , strategy_{pool.bulk_.strategy}
+        , grain_{
+            std::cmp_less(pool.bulk_.grain, shape)
+              ? static_cast<Shape>(std::max<std::size_t>(pool.bulk_.grain, 1))
+              : shape}
         , thread_with_exception_{num_agents_required()}
-        , tasks_{num_agents_required(), {this}} {
+        , task_alloc_(receiver_allocator(rcvr_))
+        , tasks_{allocate_tasks()} {
+        for (std::uint32_t i = 0; i < num_agents_required(); ++i) {
+          auto [first, last] = bulk_tree_children(i, num_agents_required());
+          ::new (static_cast<void*>(tasks_ + i)) bulk_task{this, 1 + last - first};
+        }
+      }
+
+      ~bulk_shared_state() {
+        static_assert(std::is_trivially_destructible_v<bulk_task>);
+        if (tasks_ != reinterpret_cast<bulk_task*>(inline_tasks_)) {
+          std::allocator_traits<task_allocator_t>::deallocate(
+            task_alloc_, tasks_, num_agents_required());
+        }
+      }
+
+      auto allocate_tasks() -> bulk_task* {
+        if (num_agents_required() <= inline_task_count) {
+          return reinterpret_cast<bulk_task*>(inline_tasks_);
+        }
+        return std::allocator_traits<task_allocator_t>::allocate(
+          task_alloc_, num_agents_required());
       }
     };
 
@@ -1227,7 +2885,7 @@ namespace exec {
 
       void enqueue() noexcept {
         shared_state_.pool_.bulk_enqueue(
-          shared_state_.tasks_.data(), shared_state_.num_agents_required());
+          shared_state_.tasks_, shared_state_.num_agents_required(), shared_state_.constraints_);
       }
 
       template <class... As>
@@ -1287,17 +2945,382 @@ namespace exec {
       using shared_state = bulk_shared_state<CvrefSender, Receiver, Shape, Fun, may_throw>;
       using inner_op_state = connect_result_t<CvrefSender, bulk_rcvr>;
 
-      shared_state shared_state_;
+      // A bulk on a scheduler that is constrained to some NUMA nodes keeps its shared state on
+      // the first of them, where its agents run. Other bulks keep it inline.
+      struct node_state_deleter {
+        void operator()(shared_state* state) const noexcept {
+          state->~shared_state();
+          numa_allocator<shared_state>(0).deallocate(state, 1);
+        }
+      };
+
+      std::optional<shared_state> local_state_;
+      std::unique_ptr<shared_state, node_state_deleter> node_state_;
+
+      inner_op_state inner_op_;
+
+      STDEXEC_MEMFN_DECL(void start)(this __t& op) noexcept {
+        start(op.inner_op_);
+      }
+
+      __t(
+        static_thread_pool_& pool,
+        Shape shape,
+        Fun fun,
+        CvrefSender&& sndr,
+        Receiver rcvr,
+        const nodemask& constraints)
+        : node_state_{make_state(pool, shape, fun, static_cast<Receiver&&>(rcvr), constraints)}
+        , inner_op_{stdexec::connect(static_cast<CvrefSender&&>(sndr), bulk_rcvr{state()})} {
+      }
+
+      auto state() noexcept -> shared_state& {
+        return node_state_ ? *node_state_ : *local_state_;
+      }
+
+      // Returns the shared state if it is allocated on a node, or null after constructing it in
+      // local_state_.
+      auto make_state(
+        static_thread_pool_& pool,
+        Shape shape,
+        Fun& fun,
+        Receiver&& rcvr,
+        const nodemask& constraints) -> shared_state* {
+        const int node = constraints == nodemask::any() ? -1 : pool.first_node(constraints);
+        if (node < 0) {
+          local_state_.emplace(pool, static_cast<Receiver&&>(rcvr), shape, fun, constraints);
+          return nullptr;
+        }
+        numa_allocator<shared_state> alloc(node);
+        shared_state* state = alloc.allocate(1);
+        if (state == nullptr) {
+          throw std::bad_alloc();
+        }
+        try {
+          ::new (static_cast<void*>(state))
+            shared_state(pool, static_cast<Receiver&&>(rcvr), shape, fun, constraints);
+        } catch (...) {
+          alloc.deallocate(state, 1);
+          throw;
+        }
+        return state;
+      }
+    };
+
+    //////////////////////////////////////////////////////////////////////////////////////////////////
+    // bulk_reduce runs as a bulk over the agents of the pool. Each agent folds its even_share of
+    // the shape into a partial result on its own cache line, and the partials are combined once
+    // after the bulk has completed.
+    template <class SenderId, std::integral Shape, class Init, class Map, class Reduce>
+    struct static_thread_pool_::bulk_reduce_sender<SenderId, Shape, Init, Map, Reduce>::__t {
+      using __id = bulk_reduce_sender;
+      using sender_concept = sender_t;
+
+      static_thread_pool_& pool_;
+      Sender sndr_;
+      Shape shape_;
+      Init init_;
+      Map map_;
+      Reduce reduce_;
+
+      template <class Self, class Env>
+      using __completions_t =
+        exec::__bulk_reduce::__completions_t<__copy_cvref_t<Self, Sender>, Env, Init>;
+
+      template <class Self, class Receiver>
+      using bulk_reduce_op_state_t = stdexec::__t<bulk_reduce_op_state<
+        __cvref_id<Self, Sender>,
+        stdexec::__id<Receiver>,
+        Shape,
+        Init,
+        Map,
+        Reduce>>;
+
+      template <__decays_to<__t> Self, receiver Receiver>
+        requires receiver_of<Receiver, __completions_t<Self, env_of_t<Receiver>>>
+      STDEXEC_MEMFN_DECL(auto connect)(this Self&& self, Receiver rcvr)
+        -> bulk_reduce_op_state_t<Self, Receiver> {
+        return bulk_reduce_op_state_t<Self, Receiver>{
+          self.pool_,
+          self.shape_,
+          static_cast<Self&&>(self).init_,
+          self.map_,
+          self.reduce_,
+          static_cast<Self&&>(self).sndr_,
+          static_cast<Receiver&&>(rcvr)};
+      }
+
+      template <__decays_to<__t> Self, class Env>
+      STDEXEC_MEMFN_DECL(auto get_completion_signatures)(this Self&&, Env&&) -> __completions_t<Self, Env> {
+        return {};
+      }
+
+      STDEXEC_MEMFN_DECL(auto get_env)(this const __t& self) noexcept -> env_of_t<const Sender&> {
+        return get_env(self.sndr_);
+      }
+    };
+
+    template <class Tp>
+    struct alignas(64) bulk_reduce_partial {
+      std::optional<Tp> value_;
+    };
+
+    template <
+      class CvrefSenderId,
+      class ReceiverId,
+      std::integral Shape,
+      class Init,
+      class Map,
+      class Reduce>
+    struct static_thread_pool_::bulk_reduce_op_state<CvrefSenderId, ReceiverId, Shape, Init, Map, Reduce>::
+      __t {
+      using __id = bulk_reduce_op_state;
+
+      using partial_t = bulk_reduce_partial<Init>;
+      using partials_t = std::vector<partial_t, receiver_allocator_t<Receiver, partial_t>>;
+
+      // The bulk function. Agent `agent` folds the indices [begin, end) of its share.
+      struct partial_fun {
+        __t* op_;
+
+        template <class... Args>
+        void operator()(std::uint32_t agent, Args&... args) const {
+          __t& op = *op_;
+          auto [begin, end] = even_share(op.shape_, agent, op.n_agents_);
+          Init acc(op.map_(begin, args...));
+          for (Shape i = begin + 1; i < end; ++i) {
+            acc = op.reduce_(std::move(acc), op.map_(i, args...));
+          }
+          op.partials_[agent].value_.emplace(std::move(acc));
+        }
+      };
+
+      struct combine_receiver {
+        using receiver_concept = receiver_t;
+        __t* op_;
+
+        template <class... As>
+        STDEXEC_MEMFN_DECL(void set_value)(this combine_receiver&& self, As&&...) noexcept {
+          __t& op = *self.op_;
+          try {
+            Init acc = std::move(op.init_);
+            for (partial_t& partial: op.partials_) {
+              acc = op.reduce_(std::move(acc), std::move(*partial.value_));
+            }
+            stdexec::set_value(static_cast<Receiver&&>(op.rcvr_), std::move(acc));
+          } catch (...) {
+            stdexec::set_error(static_cast<Receiver&&>(op.rcvr_), std::current_exception());
+          }
+        }
+
+        template <class Error>
+        STDEXEC_MEMFN_DECL(void set_error)(this combine_receiver&& self, Error&& error) noexcept {
+          stdexec::set_error(static_cast<Receiver&&>(self.op_->rcvr_), static_cast<Error&&>(error));
+        }
+
+        STDEXEC_MEMFN_DECL(void set_stopped)(this combine_receiver&& self) noexcept {
+          stdexec::set_stopped(static_cast<Receiver&&>(self.op_->rcvr_));
+        }
+
+        STDEXEC_MEMFN_DECL(auto get_env)(this const combine_receiver& self) noexcept
+          -> env_of_t<Receiver> {
+          return stdexec::get_env(self.op_->rcvr_);
+        }
+      };
+
+      using bulk_sender_type = bulk_sender_t<CvrefSender, std::uint32_t, partial_fun>;
+      using inner_op_state = connect_result_t<bulk_sender_type, combine_receiver>;
+
+      Receiver rcvr_;
+      Shape shape_;
+      Init init_;
+      Map map_;
+      Reduce reduce_;
+      std::uint32_t n_agents_;
+      partials_t partials_;
+      inner_op_state inner_op_;
+
+      STDEXEC_MEMFN_DECL(void start)(this __t& op) noexcept {
+        start(op.inner_op_);
+      }
+
+      __t(
+        static_thread_pool_& pool,
+        Shape shape,
+        Init init,
+        Map map,
+        Reduce reduce,
+        CvrefSender&& sndr,
+        Receiver rcvr)
+        : rcvr_(static_cast<Receiver&&>(rcvr))
+        , shape_(shape)
+        , init_(std::move(init))
+        , map_(std::move(map))
+        , reduce_(std::move(reduce))
+        , n_agents_(static_cast<std::uint32_t>(
+            std::min(shape, static_cast<Shape>(pool.available_parallelism()))))
+        , partials_(n_agents_, receiver_allocator_t<Receiver, partial_t>(receiver_allocator(rcvr_)))
+        , inner_op_{stdexec::connect(
+            bulk_sender_type{pool, static_cast<CvrefSender&&>(sndr), n_agents_, partial_fun{this}},
+            combine_receiver{this})} {
+      }
+    };
+
+    //////////////////////////////////////////////////////////////////////////////////////////////////
+    // bulk_scan runs as two bulks over the agents of the pool. In the first one, each agent but the
+    // last reduces its even_share of the input into a partial. In the second one, each agent folds
+    // init and the partials of the agents before it into its starting value and scans its share.
+    template <
+      class SenderId,
+      std::integral Shape,
+      class InIt,
+      class OutIt,
+      class Tp,
+      class Op>
+    struct static_thread_pool_::bulk_scan_sender<SenderId, Shape, InIt, OutIt, Tp, Op>::__t {
+      using __id = bulk_scan_sender;
+      using sender_concept = sender_t;
+
+      static_thread_pool_& pool_;
+      Sender sndr_;
+      Shape shape_;
+      InIt input_;
+      OutIt output_;
+      Tp init_;
+      Op op_;
+      exec::scan_kind kind_;
+
+      template <class Self, class Env>
+      using __completions_t = exec::__bulk_scan::__completions_t<__copy_cvref_t<Self, Sender>, Env>;
+
+      template <class Self, class Receiver>
+      using bulk_scan_op_state_t = stdexec::__t<bulk_scan_op_state<
+        __cvref_id<Self, Sender>,
+        stdexec::__id<Receiver>,
+        Shape,
+        InIt,
+        OutIt,
+        Tp,
+        Op>>;
+
+      template <__decays_to<__t> Self, receiver Receiver>
+        requires receiver_of<Receiver, __completions_t<Self, env_of_t<Receiver>>>
+      STDEXEC_MEMFN_DECL(auto connect)(this Self&& self, Receiver rcvr)
+        -> bulk_scan_op_state_t<Self, Receiver> {
+        return bulk_scan_op_state_t<Self, Receiver>{
+          self.pool_,
+          self.shape_,
+          self.input_,
+          self.output_,
+          static_cast<Self&&>(self).init_,
+          self.op_,
+          self.kind_,
+          static_cast<Self&&>(self).sndr_,
+          static_cast<Receiver&&>(rcvr)};
+      }
+
+      template <__decays_to<__t> Self, class Env>
+      STDEXEC_MEMFN_DECL(auto get_completion_signatures)(this Self&&, Env&&) -> __completions_t<Self, Env> {
+        return {};
+      }
+
+      STDEXEC_MEMFN_DECL(auto get_env)(this const __t& self) noexcept -> env_of_t<const Sender&> {
+        return get_env(self.sndr_);
+      }
+    };
+
+    template <
+      class CvrefSenderId,
+      class ReceiverId,
+      std::integral Shape,
+      class InIt,
+      class OutIt,
+      class Tp,
+      class Op>
+    struct static_thread_pool_::bulk_scan_op_state<CvrefSenderId, ReceiverId, Shape, InIt, OutIt, Tp, Op>::
+      __t {
+      using __id = bulk_scan_op_state;
+
+      using partial_t = bulk_reduce_partial<Tp>;
+      using partials_t = std::vector<partial_t, receiver_allocator_t<Receiver, partial_t>>;
+
+      struct reduce_fun {
+        __t* op_;
+
+        template <class... Args>
+        void operator()(std::uint32_t agent, Args&...) const {
+          __t& op = *op_;
+          // Nobody needs the partial of the last agent.
+          if (agent + 1 == op.n_agents_) {
+            return;
+          }
+          auto [begin, end] = even_share(op.shape_, agent, op.n_agents_);
+          Tp acc(op.input_[begin]);
+          op.partials_[agent].value_.emplace(
+            exec::__bulk_scan::__reduce_block(op.input_, begin + 1, end, std::move(acc), op.op_));
+        }
+      };
 
+      struct scan_fun {
+        __t* op_;
+
+        template <class... Args>
+        void operator()(std::uint32_t agent, Args&...) const {
+          __t& op = *op_;
+          auto [begin, end] = even_share(op.shape_, agent, op.n_agents_);
+          Tp acc = op.init_;
+          for (std::uint32_t k = 0; k < agent; ++k) {
+            acc = op.op_(std::move(acc), *op.partials_[k].value_);
+          }
+          exec::__bulk_scan::__scan_block(
+            op.input_, op.output_, begin, end, std::move(acc), op.op_, op.kind_);
+        }
+      };
+
+      using reduce_sender_t = bulk_sender_t<CvrefSender, std::uint32_t, reduce_fun>;
+      using scan_sender_t = bulk_sender_t<reduce_sender_t, std::uint32_t, scan_fun>;
+      using inner_op_state = connect_result_t<scan_sender_t, Receiver>;
+
+      Shape shape_;
+      InIt input_;
+      OutIt output_;
+      Tp init_;
+      Op op_;
+      exec::scan_kind kind_;
+      std::uint32_t n_agents_;
+      partials_t partials_;
       inner_op_state inner_op_;
 
       STDEXEC_MEMFN_DECL(void start)(this __t& op) noexcept {
         start(op.inner_op_);
       }
 
-      __t(static_thread_pool_& pool, Shape shape, Fun fun, CvrefSender&& sndr, Receiver rcvr)
-        : shared_state_(pool, static_cast<Receiver&&>(rcvr), shape, fun)
-        , inner_op_{stdexec::connect(static_cast<CvrefSender&&>(sndr), bulk_rcvr{shared_state_})} {
+      __t(
+        static_thread_pool_& pool,
+        Shape shape,
+        InIt input,
+        OutIt output,
+        Tp init,
+        Op op,
+        exec::scan_kind kind,
+        CvrefSender&& sndr,
+        Receiver rcvr)
+        : shape_(shape)
+        , input_(std::move(input))
+        , output_(std::move(output))
+        , init_(std::move(init))
+        , op_(std::move(op))
+        , kind_(kind)
+        , n_agents_(static_cast<std::uint32_t>(
+            std::min(shape, static_cast<Shape>(pool.available_parallelism()))))
+        , partials_(n_agents_, receiver_allocator_t<Receiver, partial_t>(receiver_allocator(rcvr)))
+        , inner_op_{stdexec::connect(
+            scan_sender_t{
+              pool,
+              reduce_sender_t{pool, static_cast<CvrefSender&&>(sndr), n_agents_, reduce_fun{this}},
+              n_agents_,
+              scan_fun{this}},
+            static_cast<Receiver&&>(rcvr))} {
       }
     };
 
@@ -1573,12 +3596,28 @@ namespace exec {
       : _pool_::static_thread_pool_(threadCount, params, numa) {
     }
 
+    explicit static_thread_pool(static_thread_pool_params options)
+      : _pool_::static_thread_pool_(std::move(options)) {
+    }
+
     // struct scheduler;
     using _pool_::static_thread_pool_::scheduler;
 
     // scheduler get_scheduler() noexcept;
     using _pool_::static_thread_pool_::get_scheduler;
 
+    // class submission_batch;
+    using _pool_::static_thread_pool_::submission_batch;
+
+    // submission_batch make_submission_batch() noexcept;
+    using _pool_::static_thread_pool_::make_submission_batch;
+
+    // scheduler get_scheduler_with_priority(std::uint32_t priority) noexcept;
+    using _pool_::static_thread_pool_::get_scheduler_with_priority;
+
+    // static constexpr std::uint32_t max_priority;
+    using _pool_::static_thread_pool_::max_priority;
+
     // scheduler get_scheduler_on_thread(std::size_t threadIndex) noexcept;
     using _pool_::static_thread_pool_::get_scheduler_on_thread;
 
@@ -1593,6 +3632,12 @@ namespace exec {
 
     // bwos_params params() const;
     using _pool_::static_thread_pool_::params;
+
+    // std::uint32_t live_threads() const noexcept;
+    using _pool_::static_thread_pool_::live_threads;
+
+    // thread_pool_metrics metrics() const;
+    using _pool_::static_thread_pool_::metrics;
   };
 
 #if STDEXEC_HAS_STD_RANGES()